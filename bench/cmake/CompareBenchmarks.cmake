@@ -0,0 +1,112 @@
+# Compares two google benchmark JSON reports, fails if throughput of a benchmark dropped more than
+# THRESHOLD percent.
+#
+# cmake -DBASELINE=baseline.json -DCURRENT=current.json -DTHRESHOLD=10 -P CompareBenchmarks.cmake
+#
+# Medians of repetitions are compared when reports have aggregates, single runs otherwise. Benchmarks
+# missing in the baseline are reported and skipped.
+
+cmake_minimum_required(VERSION 3.19...4.2.0)
+
+foreach(argument BASELINE CURRENT THRESHOLD)
+  if(NOT DEFINED ${argument})
+    message(FATAL_ERROR "${argument} is not set")
+  endif()
+endforeach()
+
+# Converts JSON number of bytes per second to whole MB/s, math() has no floating point
+function(to_megabytes value output)
+  if(NOT value MATCHES "^([0-9]+)(\\.([0-9]*))?([eE]([+-]?[0-9]+))?$")
+    message(FATAL_ERROR "unexpected throughput ${value}")
+  endif()
+
+  set(digits "${CMAKE_MATCH_1}${CMAKE_MATCH_3}")
+  string(LENGTH "${CMAKE_MATCH_3}" fractionDigits)
+  set(exponent 0)
+  if(CMAKE_MATCH_5)
+    set(exponent "${CMAKE_MATCH_5}")
+  endif()
+  math(EXPR shift "${exponent} - ${fractionDigits} - 6")
+
+  if(shift GREATER_EQUAL 0)
+    string(REPEAT "0" ${shift} zeros)
+    string(APPEND digits "${zeros}")
+  else()
+    string(LENGTH "${digits}" length)
+    math(EXPR length "${length} + ${shift}")
+    if(length LESS_EQUAL 0)
+      set(digits 0)
+    else()
+      string(SUBSTRING "${digits}" 0 ${length} digits)
+    endif()
+  endif()
+
+  string(REGEX REPLACE "^0+([0-9])" "\\1" digits "${digits}")
+  set(${output} "${digits}" PARENT_SCOPE)
+endfunction()
+
+# Reads MB/s of every benchmark into <prefix>_names and <prefix>_<C identifier of name> variables
+function(read_throughput path prefix)
+  if(NOT EXISTS "${path}")
+    message(FATAL_ERROR "benchmark report ${path} does not exist")
+  endif()
+
+  file(READ "${path}" report)
+  string(JSON count LENGTH "${report}" benchmarks)
+  set(names)
+  if(count GREATER 0)
+    math(EXPR last "${count} - 1")
+    foreach(index RANGE ${last})
+      string(JSON entry GET "${report}" benchmarks ${index})
+      string(JSON runType ERROR_VARIABLE missing GET "${entry}" run_type)
+      string(JSON aggregate ERROR_VARIABLE noAggregate GET "${entry}" aggregate_name)
+      if(runType STREQUAL "aggregate" AND NOT aggregate STREQUAL "median")
+        continue()
+      endif()
+      string(JSON throughput ERROR_VARIABLE noThroughput GET "${entry}" bytes_per_second)
+      if(noThroughput)
+        continue()
+      endif()
+
+      string(JSON name GET "${entry}" run_name)
+      list(APPEND names "${name}")
+      string(MAKE_C_IDENTIFIER "${name}" key)
+      to_megabytes("${throughput}" megabytes)
+      # a median replaces single runs of the same benchmark
+      set(${prefix}_${key} "${megabytes}" PARENT_SCOPE)
+    endforeach()
+  endif()
+
+  list(REMOVE_DUPLICATES names)
+  set(${prefix}_names "${names}" PARENT_SCOPE)
+endfunction()
+
+read_throughput("${BASELINE}" baseline)
+read_throughput("${CURRENT}" current)
+
+set(regressions 0)
+foreach(name IN LISTS current_names)
+  string(MAKE_C_IDENTIFIER "${name}" key)
+  if(NOT DEFINED baseline_${key})
+    message(STATUS "${name}: not in baseline")
+    continue()
+  endif()
+
+  set(baselineMBs "${baseline_${key}}")
+  set(currentMBs "${current_${key}}")
+  if(baselineMBs EQUAL 0)
+    continue()
+  endif()
+  math(EXPR change "(${currentMBs} - ${baselineMBs}) * 100 / ${baselineMBs}")
+
+  if(change LESS -${THRESHOLD})
+    message(STATUS "${name}: ${baselineMBs} -> ${currentMBs} MB/s (${change}%) REGRESSION")
+    math(EXPR regressions "${regressions} + 1")
+  else()
+    message(STATUS "${name}: ${baselineMBs} -> ${currentMBs} MB/s (${change}%)")
+  endif()
+endforeach()
+
+if(regressions GREATER 0)
+  message(FATAL_ERROR "${regressions} benchmarks lost more than ${THRESHOLD}% of throughput")
+endif()
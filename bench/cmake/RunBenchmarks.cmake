@@ -0,0 +1,27 @@
+# Runs a google benchmark executable with arguments of the regression check and writes JSON report.
+#
+# cmake -DBENCHMARK=base32Benchmarks -DOUTPUT=report.json [-DFILTER=regex] -P RunBenchmarks.cmake
+#
+# Baseline and current reports are both made by this script, CI runs the baseline executable built from the
+# target branch through the script of the checked out one, so both sides use the same filter and repetitions.
+
+cmake_minimum_required(VERSION 3.19...4.2.0)
+
+foreach(argument BENCHMARK OUTPUT)
+  if(NOT DEFINED ${argument})
+    message(FATAL_ERROR "${argument} is not set")
+  endif()
+endforeach()
+
+if(NOT FILTER)
+  set(FILTER "^(encode|decode)/[a-z0-9]+/size:(4096|262144)/padded:1")
+endif()
+
+execute_process(
+  COMMAND "${BENCHMARK}" --benchmark_filter=${FILTER} --benchmark_repetitions=5
+          --benchmark_report_aggregates_only=true --benchmark_out_format=json --benchmark_out=${OUTPUT}
+  RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "${BENCHMARK} failed: ${result}")
+endif()
@@ -0,0 +1,169 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "base32/base32.hpp"
+
+namespace {
+  constexpr int64_t gMinSize = 8;
+  constexpr int64_t gMaxSize = 64LL * 1024 * 1024;
+  constexpr int64_t gSizeMultiplier = 8;
+
+  /*!
+   * \brief gWhitespaceInterval
+   *
+   * whitespace is inserted after every 8 characters, like in grouped human readable tokens
+   */
+  constexpr size_t gWhitespaceInterval = 8;
+
+  /*!
+   * \brief gDecodeOptions
+   *
+   * encoded inputs of the largest sizes with padding or whitespaces are longer than the default decode limit
+   */
+  constexpr base32::DecodeOptions gDecodeOptions{.maxInputLength = base32::gNoInputLimit};
+
+  constexpr std::pair<base32::Backend, const char*> gBackends[] = {
+      {base32::Backend::Scalar, "scalar"}, {base32::Backend::Sse41, "sse41"},
+      {base32::Backend::Avx2, "avx2"},     {base32::Backend::Avx512, "avx512"},
+      {base32::Backend::Neon, "neon"},
+  };
+
+  /*!
+   * \brief makeInput
+   * \param size
+   * \param padded false to round size down to whole 5 bytes blocks
+   * \return pseudo random bytes
+   */
+  base32::Bytes makeInput(int64_t size, bool padded) {
+    auto bytes = static_cast<size_t>(size);
+    if (!padded) {
+      bytes -= bytes % 5;
+    } else if (bytes % 5 == 0) {
+      bytes -= 1;
+    }
+
+    base32::Bytes input(bytes);
+    uint32_t state = 0x9E3779B9;
+    for (auto& byte: input) {
+      state = state * 1664525 + 1013904223;
+      byte = static_cast<uint8_t>(state >> 24U);
+    }
+
+    return input;
+  }
+
+  void encodeBench(benchmark::State& state, base32::Backend backend) {
+    base32::selectBackend(backend);
+    const auto input = makeInput(state.range(0), state.range(1) != 0);
+    std::string output(base32::encodedSize(input.size()), '\0');
+    base32::Error err{};
+
+    for (auto _: state) {
+      benchmark::DoNotOptimize(base32::encodeInto(input, output, err));
+      benchmark::ClobberMemory();
+    }
+
+    if (err != base32::Error::NoError) {
+      state.SkipWithError("encoding failed");
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+    base32::resetBackend();
+  }
+
+  /*!
+   * \brief makeEncoded
+   * \return encoded input of decode benchmarks, args are input size, padding and whitespaces
+   */
+  std::string makeEncoded(const benchmark::State& state) {
+    base32::Error err{};
+    std::string input = base32::encode(makeInput(state.range(0), state.range(1) != 0), err);
+    if (state.range(2) != 0) {
+      std::string spaced;
+      spaced.reserve(input.size() + input.size() / gWhitespaceInterval);
+      for (size_t i = 0; i < input.size(); i += gWhitespaceInterval) {
+        spaced.append(input, i, gWhitespaceInterval).push_back(' ');
+      }
+      input = std::move(spaced);
+    }
+
+    return input;
+  }
+
+  void decodeBench(benchmark::State& state, base32::Backend backend) {
+    base32::selectBackend(backend);
+    base32::Error err{};
+    const std::string input = makeEncoded(state);
+    base32::Bytes output(base32::maxDecodedSize(input.size()));
+
+    for (auto _: state) {
+      benchmark::DoNotOptimize(base32::decodeInto(input, output, err, gDecodeOptions));
+      benchmark::ClobberMemory();
+    }
+
+    if (err != base32::Error::NoError) {
+      state.SkipWithError("decoding failed");
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+    base32::resetBackend();
+  }
+
+  void validateBench(benchmark::State& state, base32::Backend backend) {
+    base32::selectBackend(backend);
+    const std::string input = makeEncoded(state);
+    base32::Error err{};
+
+    for (auto _: state) {
+      err = base32::validate(input, gDecodeOptions);
+      benchmark::DoNotOptimize(err);
+    }
+
+    if (err != base32::Error::NoError) {
+      state.SkipWithError("validation failed");
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+    base32::resetBackend();
+  }
+
+  /*!
+   * \brief registerBenchmarks
+   *
+   * encode, decode and validate benchmarks for every backend supported by current CPU,
+   * args are input size, padding and whitespaces
+   */
+  void registerBenchmarks() {
+    for (const auto& [backend, name]: gBackends) {
+      if (!base32::isBackendSupported(backend)) {
+        continue;
+      }
+
+      benchmark::RegisterBenchmark((std::string("encode/") + name).c_str(), encodeBench, backend)
+          ->ArgNames({"size", "padded"})
+          ->ArgsProduct({benchmark::CreateRange(gMinSize, gMaxSize, gSizeMultiplier), {0, 1}});
+
+      benchmark::RegisterBenchmark((std::string("decode/") + name).c_str(), decodeBench, backend)
+          ->ArgNames({"size", "padded", "spaces"})
+          ->ArgsProduct({benchmark::CreateRange(gMinSize, gMaxSize, gSizeMultiplier), {0, 1}, {0, 1}});
+
+      benchmark::RegisterBenchmark((std::string("validate/") + name).c_str(), validateBench, backend)
+          ->ArgNames({"size", "padded", "spaces"})
+          ->ArgsProduct({benchmark::CreateRange(gMinSize, gMaxSize, gSizeMultiplier), {0, 1}, {0, 1}});
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  registerBenchmarks();
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  return 0;
+}
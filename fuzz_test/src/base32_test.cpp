@@ -4,8 +4,110 @@
 #include "absl/debugging/symbolize.h"
 
 #include <base32/base32.hpp>
+#include <array>
 #include <cstdlib>
+#include <string>
 #include <string_view>
+#include <vector>
+
+namespace {
+  constexpr std::array gBackends = {base32::Backend::Scalar, base32::Backend::Sse41, base32::Backend::Avx2,
+                                    base32::Backend::Avx512, base32::Backend::Neon};
+
+  /*!
+   * \brief supportedBackends
+   * \return accelerated backends current CPU can run, scalar reference excluded
+   */
+  std::vector<base32::Backend> supportedBackends() {
+    std::vector<base32::Backend> backends;
+    for (const auto backend: gBackends) {
+      if (backend != base32::Backend::Scalar && base32::isBackendSupported(backend)) {
+        backends.push_back(backend);
+      }
+    }
+
+    return backends;
+  }
+
+  /*!
+   * \brief The BackendScope class
+   *
+   * Selects backend for its lifetime
+   */
+  class BackendScope {
+  public:
+    explicit BackendScope(base32::Backend backend) {
+      EXPECT_TRUE(base32::selectBackend(backend));
+    }
+
+    ~BackendScope() {
+      base32::resetBackend();
+    }
+
+    BackendScope(const BackendScope&) = delete;
+    BackendScope& operator=(const BackendScope&) = delete;
+  };
+
+  /*!
+   * \brief The DecodeResult struct
+   *
+   * everything a decoder reports, compared between backends
+   */
+  struct DecodeResult {
+    std::expected<base32::Bytes, base32::DecodeError> decoded;
+    base32::Error validated;
+    size_t decodedSize;
+    base32::Error decodedSizeError;
+  };
+
+  DecodeResult decodeAll(std::string_view encoded, const base32::DecodeOptions& options) {
+    DecodeResult result{base32::decode(encoded, options), base32::validate(encoded, options), 0, {}};
+    result.decodedSize = base32::decodedSize(encoded, result.decodedSizeError, options);
+
+    return result;
+  }
+
+  /*!
+   * \brief gParallelInputBytes
+   *
+   * Parallel code splits only inputs of several 256 KB slices, fuzzed data is spliced into input of this size
+   */
+  constexpr size_t gParallelInputBytes = 2ULL * 1024 * 1024 + 3;
+
+  const base32::Bytes& parallelInput() {
+    static const base32::Bytes bytes = [] {
+      base32::Bytes input(gParallelInputBytes);
+      for (size_t i = 0; i < input.size(); i++) {
+        input[i] = static_cast<uint8_t>(i * 131 + i / 7);
+      }
+      return input;
+    }();
+
+    return bytes;
+  }
+
+  const std::string& parallelEncoded() {
+    static const std::string encoded = [] {
+      base32::Error err{};
+      return base32::encode(parallelInput(), err, {.maxInputLength = base32::gNoInputLimit});
+    }();
+
+    return encoded;
+  }
+
+  void expectSameDecoding(const DecodeResult& reference, const DecodeResult& result) {
+    ASSERT_EQ(reference.decoded.has_value(), result.decoded.has_value());
+    if (reference.decoded.has_value()) {
+      EXPECT_EQ(*reference.decoded, *result.decoded);
+    } else {
+      EXPECT_EQ(reference.decoded.error().error, result.decoded.error().error);
+      EXPECT_EQ(reference.decoded.error().offset, result.decoded.error().offset);
+    }
+    EXPECT_EQ(reference.validated, result.validated);
+    EXPECT_EQ(reference.decodedSize, result.decodedSize);
+    EXPECT_EQ(reference.decodedSizeError, result.decodedSizeError);
+  }
+}
 
 void base32DecodeNotCrashes(std::string_view encoded) {
   base32::Error err{};
@@ -20,3 +122,112 @@ void base32EncodeNotCrashes(const base32::Bytes& bytes) {
 }
 
 FUZZ_TEST(Base32Suite, base32EncodeNotCrashes);
+
+void base32EncodeMatchesScalar(const base32::Bytes& bytes, bool padding, size_t lineWidth) {
+  base32::Error err{};
+  const base32::EncodeOptions options{.padding = padding ? base32::Padding::Enabled : base32::Padding::Disabled,
+                                      .lineWidth = lineWidth};
+  std::string reference;
+  {
+    const BackendScope scope(base32::Backend::Scalar);
+    reference = base32::encode(bytes, err, options);
+    ASSERT_EQ(err, base32::Error::NoError);
+  }
+
+  for (const auto backend: supportedBackends()) {
+    const BackendScope scope(backend);
+    EXPECT_EQ(base32::encode(bytes, err, options), reference);
+    EXPECT_EQ(err, base32::Error::NoError);
+  }
+}
+
+FUZZ_TEST(Base32Suite, base32EncodeMatchesScalar)
+    .WithDomains(fuzztest::Arbitrary<base32::Bytes>(), fuzztest::Arbitrary<bool>(), fuzztest::InRange<size_t>(0, 100));
+
+void base32RoundTripsAcrossBackends(const base32::Bytes& bytes) {
+  base32::Error err{};
+  std::string encoded;
+  {
+    const BackendScope scope(base32::Backend::Scalar);
+    encoded = base32::encode(bytes, err);
+  }
+
+  // encoded by reference, decoded by every backend, and the other way
+  for (const auto backend: supportedBackends()) {
+    const BackendScope scope(backend);
+    EXPECT_EQ(base32::decode(encoded, err), bytes);
+    EXPECT_EQ(err, base32::Error::NoError);
+
+    const std::string accelerated = base32::encode(bytes, err);
+    const BackendScope reference(base32::Backend::Scalar);
+    EXPECT_EQ(base32::decode(accelerated, err), bytes);
+  }
+}
+
+FUZZ_TEST(Base32Suite, base32RoundTripsAcrossBackends);
+
+void base32DecodeMatchesScalar(const std::string& encoded, bool ignoreCase, bool skipAllWhitespaces,
+                               bool requirePadding) {
+  const base32::DecodeOptions options{.ignoreCase = ignoreCase,
+                                      .skipAllWhitespaces = skipAllWhitespaces,
+                                      .requirePadding = requirePadding};
+  DecodeResult reference;
+  {
+    const BackendScope scope(base32::Backend::Scalar);
+    reference = decodeAll(encoded, options);
+  }
+
+  for (const auto backend: supportedBackends()) {
+    const BackendScope scope(backend);
+    expectSameDecoding(reference, decodeAll(encoded, options));
+  }
+}
+
+// alphabet, padding, skipped and invalid characters, so inputs get past the first block and reach kernels
+FUZZ_TEST(Base32Suite, base32DecodeMatchesScalar)
+    .WithDomains(fuzztest::StringOf(fuzztest::ElementOf<char>({'A', 'M', 'Z', '2', '7', 'a', 'z', '0', '1', '8', '=',
+                                                              ' ', '\n', '\r', '-', '!', '\0', '\x80'})),
+                 fuzztest::Arbitrary<bool>(), fuzztest::Arbitrary<bool>(), fuzztest::Arbitrary<bool>());
+
+void base32DecodeArbitraryMatchesScalar(const std::string& encoded) {
+  base32DecodeMatchesScalar(encoded, false, false, false);
+}
+
+FUZZ_TEST(Base32Suite, base32DecodeArbitraryMatchesScalar);
+
+void base32ParallelEncodeMatchesSequential(const base32::Bytes& piece, size_t position) {
+  base32::Bytes bytes = parallelInput();
+  bytes.insert(bytes.begin() + static_cast<std::ptrdiff_t>(position % bytes.size()), piece.begin(), piece.end());
+  base32::Error err{};
+  const base32::EncodeOptions options{.maxInputLength = base32::gNoInputLimit};
+  const std::string reference = base32::encode(bytes, err, options);
+
+  base32::EncodeOptions parallelOptions = options;
+  parallelOptions.threads = 4;
+  parallelOptions.parallelThreshold = 0;
+  EXPECT_EQ(base32::encode(bytes, err, parallelOptions), reference);
+  EXPECT_EQ(err, base32::Error::NoError);
+}
+
+FUZZ_TEST(Base32Suite, base32ParallelEncodeMatchesSequential);
+
+void base32ParallelDecodeMatchesSequential(const std::string& piece, size_t position, bool skipAllWhitespaces,
+                                          bool requirePadding) {
+  std::string encoded = parallelEncoded();
+  encoded.insert(position % encoded.size(), piece);
+  const base32::DecodeOptions options{.skipAllWhitespaces = skipAllWhitespaces,
+                                      .requirePadding = requirePadding,
+                                      .maxInputLength = base32::gNoInputLimit};
+  const DecodeResult reference = decodeAll(encoded, options);
+
+  base32::DecodeOptions parallelOptions = options;
+  parallelOptions.threads = 4;
+  parallelOptions.parallelThreshold = 0;
+  expectSameDecoding(reference, decodeAll(encoded, parallelOptions));
+}
+
+// fuzzed characters anywhere in input long enough to be split between threads
+FUZZ_TEST(Base32Suite, base32ParallelDecodeMatchesSequential)
+    .WithDomains(fuzztest::StringOf(fuzztest::ElementOf<char>({'A', 'M', 'Z', '2', '7', 'a', '0', '=', ' ', '\n', '\r',
+                                                              '-', '!'})),
+                 fuzztest::Arbitrary<size_t>(), fuzztest::Arbitrary<bool>(), fuzztest::Arbitrary<bool>());
@@ -0,0 +1,211 @@
+#pragma once
+#include "base32/base32.hpp"
+
+#include <algorithm>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace base32 {
+  /*!
+   * \brief gAsyncChunkBlocks
+   *
+   * Default number of blocks asyncEncode and asyncDecode read at once, it bounds their buffers
+   */
+  constexpr size_t gAsyncChunkBlocks = 4096;
+
+  /*! \brief Source of elements read by co_await source.read(buffer)
+   *
+   *  read fills the front of buffer and resumes with the number of elements read, 0 at end of stream.
+   */
+  template <typename Source, typename Element>
+  concept AsyncSource = requires(Source& source, std::span<Element> buffer) { source.read(buffer); };
+
+  /*! \brief Sink of elements written by co_await sink.write(data)
+   *
+   *  write resumes once the whole data is accepted, data may be reused after that, so a slow sink
+   *  holds the producer back.
+   */
+  template <typename Sink, typename Element>
+  concept AsyncSink = requires(Sink& sink, std::span<const Element> data) { sink.write(data); };
+
+  /*! \brief Lazy coroutine returning T, started when awaited
+   *
+   *  The awaiting coroutine is resumed by symmetric transfer when the task finishes, exceptions of the
+   *  task are rethrown to it.
+   */
+  template <typename T>
+  class [[nodiscard]] Task {
+  public:
+    struct promise_type {
+      Task get_return_object() {
+        return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+      }
+
+      std::suspend_always initial_suspend() noexcept {
+        return {};
+      }
+
+      auto final_suspend() noexcept {
+        struct FinalAwaiter {
+          bool await_ready() noexcept {
+            return false;
+          }
+
+          std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+            const std::coroutine_handle<> continuation = handle.promise().continuation;
+            return continuation ? continuation : std::noop_coroutine();
+          }
+
+          void await_resume() noexcept {}
+        };
+
+        return FinalAwaiter{};
+      }
+
+      void return_value(T value) {
+        result.emplace(std::move(value));
+      }
+
+      void unhandled_exception() {
+        exception = std::current_exception();
+      }
+
+      std::optional<T> result;
+      std::exception_ptr exception;
+      std::coroutine_handle<> continuation;
+    };
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    Task& operator=(Task&& other) noexcept {
+      if (this != &other) {
+        destroy();
+        handle_ = std::exchange(other.handle_, nullptr);
+      }
+
+      return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+      destroy();
+    }
+
+    bool await_ready() const noexcept {
+      return false;
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+      handle_.promise().continuation = awaiting;
+      return handle_;
+    }
+
+    T await_resume() {
+      if (handle_.promise().exception) {
+        std::rethrow_exception(handle_.promise().exception);
+      }
+
+      return std::move(*handle_.promise().result);
+    }
+
+  private:
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    void destroy() {
+      if (handle_) {
+        handle_.destroy();
+      }
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+  };
+
+  /*! \brief Encode stream pulled from source into sink without blocking
+   *
+   *  Reads chunks of up to chunkBlocks*5 bytes, every chunk is encoded by Encoder and written before
+   *  the next one is read, so the adapter holds one chunk and its characters however long the stream is.
+   *  Output is padded. Source and sink must outlive the task.
+   *
+   *  \code
+   *  const base32::Error err = co_await base32::asyncEncode(socket, file);
+   *  \endcode
+   *
+   *  \param source of bytes
+   *  \param sink of characters
+   *  \param chunkBlocks number of 5 bytes blocks read at once, at least 1
+   *  \return NoError when source ended and everything was written
+   */
+  template <AsyncSource<uint8_t> Source, AsyncSink<char> Sink>
+  Task<Error> asyncEncode(Source& source, Sink& sink, size_t chunkBlocks = gAsyncChunkBlocks) {
+    Encoder encoder;
+    // an empty buffer reads nothing and would look like end of stream
+    chunkBlocks = std::max<size_t>(chunkBlocks, 1);
+    std::vector<uint8_t> input(chunkBlocks * 5);
+    // carried over bytes and a chunk of whole blocks never make more than chunkBlocks blocks
+    std::vector<char> output(chunkBlocks * 8);
+
+    Error errCode = Error::NoError;
+    while (const size_t read = co_await source.read(std::span<uint8_t>(input))) {
+      const size_t written = encoder.update(std::span<const uint8_t>(input).first(read), output, errCode);
+      if (errCode != Error::NoError) {
+        co_return errCode;
+      }
+      if (written != 0) {
+        co_await sink.write(std::span<const char>(output).first(written));
+      }
+    }
+
+    const size_t written = encoder.finalize(output, errCode);
+    if (errCode == Error::NoError && written != 0) {
+      co_await sink.write(std::span<const char>(output).first(written));
+    }
+
+    co_return errCode;
+  }
+
+  /*! \brief Decode stream pulled from source into sink without blocking
+   *
+   *  Reads chunks of up to chunkBlocks*8 characters, every chunk is decoded by Decoder and written before
+   *  the next one is read. Decoding stops at the first invalid character, bytes of that chunk are not
+   *  written then. Source and sink must outlive the task.
+   *
+   *  \param source of characters
+   *  \param sink of bytes
+   *  \param chunkBlocks number of 8 characters blocks read at once, at least 1
+   *  \return NoError when source ended and everything was written, InvalidB32Input on invalid characters
+   */
+  template <AsyncSource<char> Source, AsyncSink<uint8_t> Sink>
+  Task<Error> asyncDecode(Source& source, Sink& sink, size_t chunkBlocks = gAsyncChunkBlocks) {
+    Decoder decoder;
+    chunkBlocks = std::max<size_t>(chunkBlocks, 1);
+    std::vector<char> input(chunkBlocks * 8);
+    std::vector<uint8_t> output(chunkBlocks * 5);
+
+    Error errCode = Error::NoError;
+    while (const size_t read = co_await source.read(std::span<char>(input))) {
+      const size_t written = decoder.update(std::string_view(input.data(), read), output, errCode);
+      if (errCode != Error::NoError) {
+        co_return errCode;
+      }
+      if (written != 0) {
+        co_await sink.write(std::span<const uint8_t>(output).first(written));
+      }
+    }
+
+    const size_t written = decoder.finalize(output, errCode);
+    if (errCode == Error::NoError && written != 0) {
+      co_await sink.write(std::span<const uint8_t>(output).first(written));
+    }
+
+    co_return errCode;
+  }
+}  // namespace base32
@@ -1,7 +1,18 @@
 #pragma once
+#include "base32/tables.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <expected>
+#include <limits>
+#include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 /*! \mainpage base32
@@ -12,6 +23,15 @@
  *
  */
 
+/*!
+ * \brief Default max number of bytes to encode, may be defined at compile time
+ *
+ * Options of every call may raise or lower it, e.g. -DBASE32_MAX_ENCODE_INPUT_LEN=SIZE_MAX removes the limit
+ */
+#ifndef BASE32_MAX_ENCODE_INPUT_LEN
+#  define BASE32_MAX_ENCODE_INPUT_LEN (64ULL * 1024 * 1024)
+#endif
+
 /*! \brief namespace that contains base32 encoding and decoding functions
  *
  */
@@ -24,19 +44,159 @@ namespace base32 {
     NoError = 0,
     InvalidB32Input,
     MaxLengthExceeded,
-    EmptyString
+    EmptyString,
+    BufferTooSmall,
+    IoError
+  };
+
+  /*!
+   * \brief Implementations of encoding and decoding kernels
+   *
+   * The fastest backend supported by CPU is selected on first use
+   */
+  enum class Backend: uint8_t {
+    Scalar = 0,
+    Sse41,
+    Avx2,
+    Avx512,
+    Neon
+  };
+
+  /*!
+   * \brief Trailing '=' of the last incomplete block
+   */
+  enum class Padding: uint8_t {
+    Enabled = 0,
+    Disabled
+  };
+
+  /*!
+   * \brief Decoding failure
+   */
+  struct DecodeError {
+    Error error;
+
+    /*!
+     * \brief index of the first input character decoding failed on
+     *
+     * Start of padding if padding is wrong, max input length if input is too long
+     */
+    size_t offset;
   };
 
+  /*!
+   * \brief Input length to pass as maxInputLength of options for no limit
+   */
+  constexpr size_t gNoInputLimit = std::numeric_limits<size_t>::max();
+
+  /*!
+   * \brief Default max number of bytes to encode
+   */
+  constexpr size_t gDefaultMaxEncodeInputLen = BASE32_MAX_ENCODE_INPUT_LEN;
+
+  /*!
+   * \brief Default max number of characters to decode
+   *
+   * If max input of encoding is encoded than it should be also possible to decode it, that's why a bigger input is allowed for decoding
+   * Padded encoding of the max input, so input of any padding fits
+   */
+  constexpr size_t gDefaultMaxDecodeInputLen =
+    gDefaultMaxEncodeInputLen / 5 + (gDefaultMaxEncodeInputLen % 5 != 0 ? 1 : 0) > gNoInputLimit / 8
+      ? gNoInputLimit
+      : gDefaultMaxEncodeInputLen / 5 * 8 + (gDefaultMaxEncodeInputLen % 5 != 0 ? 8 : 0);
+
   /*!
    * \brief bytes alias
    */
   using Bytes = std::vector<uint8_t>;
 
+  /*!
+   * \brief Encoding settings
+   */
+  struct EncodeOptions {
+    /*!
+     * \brief number of threads encoding input of parallelThreshold bytes or more, 0 for hardware concurrency
+     */
+    unsigned threads = 1;
+
+    /*!
+     * \brief min input size split between threads
+     */
+    size_t parallelThreshold = 4ULL * 1024 * 1024;
+
+    /*!
+     * \brief Disabled omits '=' of the last block, codecs use their own Padding argument instead
+     */
+    Padding padding = Padding::Enabled;
+
+    /*!
+     * \brief longer input is rejected with MaxLengthExceeded, gNoInputLimit accepts any input encoded length fits size_t
+     */
+    size_t maxInputLength = gDefaultMaxEncodeInputLen;
+
+    /*!
+     * \brief number of characters per line, lineSeparator is put between lines, 0 disables wrapping
+     *
+     * Wrapped output is encoded by one thread
+     */
+    size_t lineWidth = 0;
+
+    /*!
+     * \brief put between lines of wrapped output, e.g. "\r\n" of MIME or "\n" of PEM
+     */
+    std::string_view lineSeparator = "\r\n";
+  };
+
+  /*!
+   * \brief Decoding settings
+   */
+  struct DecodeOptions {
+    /*!
+     * \brief number of threads decoding input of parallelThreshold characters or more, 0 for hardware concurrency
+     *
+     * Invalid input is decoded by one thread to locate the error
+     */
+    unsigned threads = 1;
+
+    /*!
+     * \brief min input size split between threads
+     */
+    size_t parallelThreshold = 4ULL * 1024 * 1024;
+
+    /*!
+     * \brief accept letters in both cases, e.g. lowercase RFC 4648 input
+     */
+    bool ignoreCase = false;
+
+    /*!
+     * \brief skip tabs and line breaks too, spaces are always skipped
+     */
+    bool skipAllWhitespaces = false;
+
+    /*!
+     * \brief decode O as 0 and I, L as 1 and skip hyphens, for alphabets without O, I, L in either case
+     *
+     * Makes decoding of human entered Crockford's base 32 codes tolerant, other alphabets in use,
+     * RFC 4648, base32hex and z-base-32, contain some of these letters and are decoded as without it
+     */
+    bool mapConfusables = false;
+
+    /*!
+     * \brief reject input which is not padded to whole blocks with '=', unpadded input is accepted by default
+     */
+    bool requirePadding = false;
+
+    /*!
+     * \brief longer input is rejected with MaxLengthExceeded, gNoInputLimit accepts any input
+     */
+    size_t maxInputLength = gDefaultMaxDecodeInputLen;
+  };
+
   /*! \brief Encode bytes as base 32 string
    *
    *  The encoding process represents 40-bit groups of input bits as output strings of 8 encoded characters.
    *
-   *  \param userData: max size is 64 MB
+   *  \param userData: max size is gDefaultMaxEncodeInputLen, 64 MB unless BASE32_MAX_ENCODE_INPUT_LEN is defined
    *  \param errCode
    *  \return base32 encoded string
    *
@@ -57,4 +217,942 @@ namespace base32 {
    *  \callergraph
    */
   Bytes decode(std::string_view userData, Error& errCode);
+
+  /*! \brief Exact length of base 32 encoded string, padding included
+   *
+   *  \param bytesCount number of bytes to encode
+   *  \return number of characters produced by encode
+   */
+  constexpr size_t encodedSize(size_t bytesCount) {
+    return bytesCount / 5 * 8 + (bytesCount % 5 != 0 ? 8 : 0);
+  }
+
+  /*! \brief Exact length of base 32 encoded string
+   *
+   *  \param bytesCount number of bytes to encode
+   *  \param padding Disabled drops '=' of the last block
+   *  \return number of characters produced by encode
+   */
+  constexpr size_t encodedSize(size_t bytesCount, Padding padding) {
+    return padding == Padding::Enabled ? encodedSize(bytesCount) : bytesCount / 5 * 8 + (bytesCount % 5 * 8 + 4) / 5;
+  }
+
+  /*! \brief internal size computations
+   */
+  namespace detail {
+    /*!
+     * \brief gMaxEncodableInputLen
+     *
+     * longest input whose encoded length fits size_t, rejected even without input limit
+     */
+    constexpr size_t gMaxEncodableInputLen = gNoInputLimit / gCharsPerB32Block * gBytesPerB32Block;
+
+    /*!
+     * \brief validateEncodeInput
+     * \param userData
+     * \param maxInputLength
+     * \return MaxLengthExceeded if input is longer than the limit or its encoded length doesn't fit size_t
+     */
+    constexpr Error validateEncodeInput(std::span<const uint8_t> userData, size_t maxInputLength) {
+      if (userData.size() > std::min(maxInputLength, gMaxEncodableInputLen)) {
+        return Error::MaxLengthExceeded;
+      }
+
+      return Error::NoError;
+    }
+
+    /*!
+     * \brief wrappedSize
+     * \param chars number of encoded characters
+     * \param options line wrapping
+     * \return chars with line separators, SIZE_MAX if it doesn't fit size_t
+     */
+    constexpr size_t wrappedSize(size_t chars, const EncodeOptions& options) {
+      if (options.lineWidth == 0 || chars == 0) {
+        return chars;
+      }
+
+      const size_t separators = (chars - 1) / options.lineWidth;
+      const size_t separatorChars = options.lineSeparator.size();
+      if (separatorChars != 0 && separators > (gNoInputLimit - chars) / separatorChars) {
+        return gNoInputLimit;
+      }
+
+      return chars + separators * separatorChars;
+    }
+  }  // namespace detail
+
+  /*! \brief Exact length of base 32 encoded string with settings of encoding
+   *
+   *  \param bytesCount number of bytes to encode
+   *  \param options padding and line wrapping
+   *  \return number of characters produced by encode, line separators included
+   */
+  constexpr size_t encodedSize(size_t bytesCount, const EncodeOptions& options) {
+    return detail::wrappedSize(encodedSize(bytesCount, options.padding), options);
+  }
+
+  /*! \brief Upper bound of decoded data length
+   *
+   *  Exact for unpadded input without whitespaces, padding and whitespaces only make the result smaller.
+   *
+   *  \param charsCount number of base 32 characters to decode
+   *  \return max number of bytes produced by decode
+   */
+  constexpr size_t maxDecodedSize(size_t charsCount) {
+    return charsCount / 8 * 5 + (charsCount % 8) * 5 / 8;
+  }
+
+  /*! \brief block primitives shared by kernels and fixed width functions
+   */
+  namespace detail {
+    /*!
+     * \brief encodeBlock
+     *
+     * Encode one full 40 bits block as 8 characters. Bounds are not checked.
+     * \param input 5 bytes
+     * \param output 8 characters
+     * \param tables
+     */
+    inline void encodeBlock(const uint8_t* input, char* output, const CodecTables& tables) {
+      const uint64_t quintuple = (uint64_t{input[0]} << 32U) | (uint64_t{input[1]} << 24U)
+                                 | (uint64_t{input[2]} << 16U) | (uint64_t{input[3]} << 8U)
+                                 | uint64_t{input[4]};
+      constexpr uint64_t mask = gB32CharPairs - 1;
+
+      std::memcpy(output + 0, tables.pairs[(quintuple >> 30U) & mask].data(), 2);
+      std::memcpy(output + 2, tables.pairs[(quintuple >> 20U) & mask].data(), 2);
+      std::memcpy(output + 4, tables.pairs[(quintuple >> 10U) & mask].data(), 2);
+      std::memcpy(output + 6, tables.pairs[quintuple & mask].data(), 2);
+    }
+
+    /*!
+     * \brief storeBlock
+     *
+     * Store 40 bits block as 5 bytes, most significant byte first
+     * \param quintuple
+     * \param output 5 bytes
+     */
+    inline void storeBlock(uint64_t quintuple, uint8_t* output) {
+      output[0] = static_cast<uint8_t>(quintuple >> 32U);
+      output[1] = static_cast<uint8_t>(quintuple >> 24U);
+      output[2] = static_cast<uint8_t>(quintuple >> 16U);
+      output[3] = static_cast<uint8_t>(quintuple >> 8U);
+      output[4] = static_cast<uint8_t>(quintuple);
+    }
+
+    /*!
+     * \brief assembleBlock
+     * \param values 8 positions in base 32 alphabet
+     * \return 40 bits block
+     */
+    inline uint64_t assembleBlock(const uint8_t* values) {
+      uint64_t quintuple = 0;
+      for (uint8_t k = 0; k < gCharsPerB32Block; ++k) {
+        quintuple = (quintuple << gBitsPerB32Char) | values[k];
+      }
+
+      return quintuple;
+    }
+
+    /*!
+     * \brief decodeBlock
+     *
+     * Decode 8 characters as 5 bytes. Bounds are not checked.
+     * \param input 8 characters
+     * \param output 5 bytes
+     * \param tables
+     * \return false if any of characters is not in base 32 alphabet or should be skipped, output is untouched then
+     */
+    inline bool decodeBlock(const uint8_t* input, uint8_t* output, const CodecTables& tables) {
+      std::array<uint8_t, gCharsPerB32Block> values{};
+      uint8_t invalidBits = 0;
+      for (uint8_t k = 0; k < gCharsPerB32Block; ++k) {
+        values[k] = tables.decode[input[k]];
+        invalidBits |= values[k];
+      }
+
+      if ((invalidBits & ~uint8_t{gB32AlphabetSize - 1}) != 0) {
+        return false;
+      }
+
+      storeBlock(assembleBlock(values.data()), output);
+
+      return true;
+    }
+
+    /*!
+     * \brief encodeFixed
+     *
+     * Encode input of size known at compile time, loops have constant trip counts and are unrolled
+     * \param input
+     * \param tables
+     * \return encoded characters
+     */
+    template <Padding padding, size_t N>
+    std::array<char, encodedSize(N, padding)> encodeFixed(const std::array<uint8_t, N>& input,
+                                                          const CodecTables& tables) {
+      constexpr size_t fullBlocks = N / gBytesPerB32Block;
+      constexpr size_t tailBytes = N % gBytesPerB32Block;
+      std::array<char, encodedSize(N, padding)> output;
+      for (size_t block = 0; block < fullBlocks; ++block) {
+        encodeBlock(input.data() + block*gBytesPerB32Block, output.data() + block*gCharsPerB32Block, tables);
+      }
+
+      if constexpr (tailBytes != 0) {
+        constexpr size_t tailChars = encodedSize(tailBytes, Padding::Disabled);
+        std::array<uint8_t, gBytesPerB32Block> lastBlock{};
+        std::memcpy(lastBlock.data(), input.data() + fullBlocks*gBytesPerB32Block, tailBytes);
+        std::array<char, gCharsPerB32Block> lastChars{};
+        encodeBlock(lastBlock.data(), lastChars.data(), tables);
+        std::memcpy(output.data() + fullBlocks*gCharsPerB32Block, lastChars.data(), tailChars);
+        if constexpr (padding == Padding::Enabled) {
+          std::memset(output.data() + fullBlocks*gCharsPerB32Block + tailChars, '=', gCharsPerB32Block - tailChars);
+        }
+      }
+
+      return output;
+    }
+
+    /*!
+     * \brief decodeFixed
+     *
+     * Decode canonical encoding of N bytes, padded or not, without branches on its characters
+     * \param input
+     * \param output
+     * \param tables
+     * \return false if input is not canonical, e.g. has whitespaces, invalid characters or another length
+     */
+    template <size_t N>
+    bool decodeFixed(std::string_view input, std::array<uint8_t, N>& output, const CodecTables& tables) {
+      constexpr size_t fullBlocks = N / gBytesPerB32Block;
+      constexpr size_t tailBytes = N % gBytesPerB32Block;
+      constexpr size_t payloadChars = encodedSize(N, Padding::Disabled);
+      if (input.size() != payloadChars && input.size() != encodedSize(N)) {
+        return false;
+      }
+
+      const auto* chars = reinterpret_cast<const uint8_t*>(input.data());
+      uint8_t invalidBits = 0;
+      std::array<uint8_t, gCharsPerB32Block> values{};
+      for (size_t block = 0; block < fullBlocks; ++block) {
+        for (size_t k = 0; k < gCharsPerB32Block; ++k) {
+          values[k] = tables.decode[chars[block*gCharsPerB32Block + k]];
+          invalidBits |= values[k];
+        }
+        storeBlock(assembleBlock(values.data()), output.data() + block*gBytesPerB32Block);
+      }
+
+      if constexpr (tailBytes != 0) {
+        constexpr size_t tailChars = payloadChars % gCharsPerB32Block;
+        values.fill(0);
+        for (size_t k = 0; k < tailChars; ++k) {
+          values[k] = tables.decode[chars[fullBlocks*gCharsPerB32Block + k]];
+          invalidBits |= values[k];
+        }
+        std::array<uint8_t, gBytesPerB32Block> lastBlock{};
+        storeBlock(assembleBlock(values.data()), lastBlock.data());
+        std::memcpy(output.data() + fullBlocks*gBytesPerB32Block, lastBlock.data(), tailBytes);
+      }
+
+      uint8_t paddingBits = 0;
+      for (size_t k = payloadChars; k < input.size(); ++k) {
+        paddingBits |= static_cast<uint8_t>(input[k] ^ '=');
+      }
+
+      return (invalidBits & ~uint8_t{gB32AlphabetSize - 1}) == 0 && paddingBits == 0;
+    }
+  }  // namespace detail
+
+  /*! \brief constexpr implementation used by compile time functions
+   */
+  namespace detail {
+    /*!
+     * \brief encodeConstexpr
+     *
+     * Char by char encoding usable in constant expressions
+     * \param input
+     * \param output at least encodedSize(input.size(), padding) characters
+     * \param tables
+     * \param padding
+     * \return number of characters written
+     */
+    constexpr size_t encodeConstexpr(std::span<const uint8_t> input, std::span<char> output, const CodecTables& tables,
+                                     Padding padding) {
+      size_t written = 0;
+      uint32_t bitsBuffer = 0;
+      uint8_t bitsCount = 0;
+      for (const uint8_t byte: input) {
+        bitsBuffer = (bitsBuffer << gBitsPerByte) | byte;
+        bitsCount += gBitsPerByte;
+        while (bitsCount >= gBitsPerB32Char) {
+          bitsCount -= gBitsPerB32Char;
+          output[written++] = tables.alphabet[(bitsBuffer >> bitsCount) & 0x1FU];
+        }
+      }
+
+      if (bitsCount > 0) {
+        output[written++] = tables.alphabet[(bitsBuffer << (gBitsPerB32Char - bitsCount)) & 0x1FU];
+      }
+      while (padding == Padding::Enabled && written % gCharsPerB32Block != 0) {
+        output[written++] = '=';
+      }
+
+      return written;
+    }
+
+    /*!
+     * \brief payloadCharsConstexpr
+     * \param input
+     * \param tables
+     * \return number of alphabet characters before trailing padding, whitespaces excluded
+     */
+    constexpr size_t payloadCharsConstexpr(std::string_view input, const CodecTables& tables) {
+      size_t payloadChars = 0;
+      for (const char chr: input) {
+        if (chr == '=') {
+          break;
+        }
+        if (tables.decode[static_cast<uint8_t>(chr)] < gB32AlphabetSize) {
+          ++payloadChars;
+        }
+      }
+
+      return payloadChars;
+    }
+
+    /*!
+     * \brief decodeConstexpr
+     *
+     * Char by char decoding usable in constant expressions, accepts the same input as decode,
+     * whitespaces are skipped and '=' is allowed only at the end
+     * \param input
+     * \param output at least maxDecodedSize(payloadCharsConstexpr(input)) bytes
+     * \param written number of bytes written to output
+     * \param tables
+     * \return error code
+     */
+    constexpr Error decodeConstexpr(std::string_view input, std::span<uint8_t> output, size_t& written,
+                                    const CodecTables& tables) {
+      while (!input.empty() && (input.back() == '=' || tables.decode[static_cast<uint8_t>(input.back())] == gSkipChar)) {
+        input.remove_suffix(1);
+      }
+
+      written = 0;
+      uint32_t bitsBuffer = 0;
+      uint8_t bitsCount = 0;
+      for (const char chr: input) {
+        const uint8_t value = tables.decode[static_cast<uint8_t>(chr)];
+        if (value == gSkipChar) {
+          continue;
+        }
+        if (value >= gB32AlphabetSize) {
+          return Error::InvalidB32Input;
+        }
+
+        bitsBuffer = (bitsBuffer << gBitsPerB32Char) | value;
+        bitsCount += gBitsPerB32Char;
+        if (bitsCount >= gBitsPerByte) {
+          bitsCount -= gBitsPerByte;
+          output[written++] = static_cast<uint8_t>(bitsBuffer >> bitsCount);
+        }
+      }
+
+      return Error::NoError;
+    }
+
+    /*!
+     * \brief invalidBase32Literal
+     *
+     * Never defined, calling it from a consteval function turns invalid input into a compilation error
+     */
+    void invalidBase32Literal();
+  }  // namespace detail
+
+  /*! \brief String literal usable as a template argument
+   */
+  template <size_t N>
+  struct Literal {
+    std::array<char, N - 1> chars{};
+
+    // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+    consteval Literal(const char (&str)[N]) {
+      for (size_t i = 0; i + 1 < N; ++i) {
+        chars[i] = str[i];
+      }
+    }
+
+    [[nodiscard]] constexpr std::string_view view() const {
+      return {chars.data(), chars.size()};
+    }
+  };
+
+  /*! \brief Encode bytes at compile time
+   *
+   *  Usable in constant expressions, so encoded constants cost nothing at runtime
+   *
+   *  \param userData
+   *  \return base 32 characters with padding, not null terminated
+   */
+  template <size_t N>
+  constexpr std::array<char, encodedSize(N)> encodeArray(const std::array<uint8_t, N>& userData) {
+    std::array<char, encodedSize(N)> encoded{};
+    detail::encodeConstexpr(userData, encoded, detail::gRfc4648Tables, Padding::Enabled);
+
+    return encoded;
+  }
+
+  /*! \brief Decode base 32 literal at compile time
+   *
+   *  Invalid input does not compile.
+   *
+   *  \return exactly as many bytes as encoded
+   */
+  template <Literal Encoded>
+  consteval auto decodeArray() {
+    constexpr size_t decodedSize = maxDecodedSize(detail::payloadCharsConstexpr(Encoded.view(), detail::gRfc4648Tables));
+    std::array<uint8_t, decodedSize> decoded{};
+    size_t written = 0;
+    if (detail::decodeConstexpr(Encoded.view(), decoded, written, detail::gRfc4648Tables) != Error::NoError) {
+      detail::invalidBase32Literal();
+    }
+
+    return decoded;
+  }
+
+  /*! \brief user defined literals
+   */
+  namespace literals {
+    /*! \brief Decode base 32 literal at compile time
+     *
+     *  \code
+     *  using namespace base32::literals;
+     *  constexpr auto magic = "MZXW6YTB"_b32;  // std::array<uint8_t, 5>
+     *  \endcode
+     */
+    template <Literal Encoded>
+    consteval auto operator""_b32() {
+      return decodeArray<Encoded>();
+    }
+  }  // namespace literals
+
+  /*! \brief Encode bytes as base 32 string into caller provided buffer
+   *
+   *  Does not allocate. Output is not null terminated.
+   *
+   *  \param userData: max size is gDefaultMaxEncodeInputLen
+   *  \param output buffer of at least encodedSize(userData.size()) characters
+   *  \param errCode BufferTooSmall if output can't hold encoded data
+   *  \return number of characters written
+   *
+   *  \callgraph
+   *  \callergraph
+   */
+  size_t encodeInto(std::span<const uint8_t> userData, std::span<char> output, Error& errCode);
+
+  /*! \brief Decode base 32 string into caller provided buffer
+   *
+   *  Does not allocate.
+   *
+   *  \param userData encoded base 32 string
+   *  \param output buffer of at least maxDecodedSize(userData.size()) bytes
+   *  \param errCode BufferTooSmall if output can't hold decoded data
+   *  \return number of bytes written
+   *
+   *  \callgraph
+   *  \callergraph
+   */
+  size_t decodeInto(std::string_view userData, std::span<uint8_t> output, Error& errCode);
+
+  /*! \brief Encode bytes as base 32 string with custom settings
+   *
+   *  \param userData: max size is options.maxInputLength
+   *  \param errCode
+   *  \param options
+   *  \return base32 encoded string
+   */
+  std::string encode(const Bytes& userData, Error& errCode, const EncodeOptions& options);
+
+  /*! \brief Decode base 32 string with custom settings
+   *
+   *  \param userData encoded base 32 string
+   *  \param errCode
+   *  \param options
+   *  \return decoded bytes
+   */
+  Bytes decode(std::string_view userData, Error& errCode, const DecodeOptions& options);
+
+  /*! \brief Encode bytes as base 32 string into caller provided buffer with custom settings
+   *
+   *  \param userData: max size is options.maxInputLength
+   *  \param output buffer of at least encodedSize(userData.size(), options) characters
+   *  \param errCode BufferTooSmall if output can't hold encoded data
+   *  \param options
+   *  \return number of characters written
+   */
+  size_t encodeInto(std::span<const uint8_t> userData, std::span<char> output, Error& errCode,
+                    const EncodeOptions& options);
+
+  /*! \brief Decode base 32 string into caller provided buffer with custom settings
+   *
+   *  \param userData encoded base 32 string
+   *  \param output buffer of at least maxDecodedSize(userData.size()) bytes
+   *  \param errCode BufferTooSmall if output can't hold decoded data
+   *  \param options
+   *  \return number of bytes written
+   */
+  size_t decodeInto(std::string_view userData, std::span<uint8_t> output, Error& errCode,
+                    const DecodeOptions& options);
+
+  /*! \brief Decode base 32 string overwriting it with decoded bytes
+   *
+   *  Decoded data is at most 5/8 of the input, so blocks are written to the front of the buffer behind
+   *  the characters still to be read and no output buffer is needed. Decoding runs on one thread,
+   *  threads of options are ignored. On error buffer holds bytes decoded so far followed by input left.
+   *
+   *  \code
+   *  std::span<uint8_t> payload = base32::decodeInPlace(message, err);
+   *  \endcode
+   *
+   *  \param buffer encoded base 32 string, max size is options.maxInputLength
+   *  \param errCode
+   *  \param options
+   *  \return decoded bytes at the front of buffer
+   */
+  std::span<uint8_t> decodeInPlace(std::span<char> buffer, Error& errCode, const DecodeOptions& options = {});
+
+  /*! \brief Encode many small inputs in one call
+   *
+   *  Encoded inputs are stored one after another without separators.
+   *  Backend lookup and output size check are done once for the whole batch.
+   *
+   *  \param inputs every input max size is gDefaultMaxEncodeInputLen
+   *  \param output arena of at least sum of encodedSize of all inputs
+   *  \param lengths number of characters written for every input, at least inputs.size() elements
+   *  \param errCode BufferTooSmall if output or lengths are too small, nothing is written then
+   *  \return total number of characters written
+   */
+  size_t encodeBatch(std::span<const std::span<const uint8_t>> inputs, std::span<char> output,
+                     std::span<size_t> lengths, Error& errCode);
+
+  /*! \brief Decode many small base 32 strings in one call
+   *
+   *  Decoded inputs are stored one after another without separators.
+   *  Decoding stops on the first invalid input, lengths of it and all the following inputs are set to 0.
+   *
+   *  \param inputs encoded base 32 strings
+   *  \param output arena of at least sum of maxDecodedSize of all inputs
+   *  \param lengths number of bytes written for every input, at least inputs.size() elements
+   *  \param errCode BufferTooSmall if output or lengths are too small, nothing is written then
+   *  \return total number of bytes written
+   */
+  size_t decodeBatch(std::span<const std::string_view> inputs, std::span<uint8_t> output,
+                     std::span<size_t> lengths, Error& errCode);
+
+  /*! \brief Decode base 32 string, reporting where decoding failed
+   *
+   *  No partial output is returned on error. Offset of the error is found only after
+   *  decoding failed, so successful decoding costs the same as decode with Error.
+   *
+   *  \param userData encoded base 32 string
+   *  \return decoded bytes or error with its offset
+   */
+  std::expected<Bytes, DecodeError> decode(std::string_view userData);
+
+  /*! \brief Decode base 32 string with custom settings, reporting where decoding failed
+   *
+   *  \param userData encoded base 32 string
+   *  \param options
+   *  \return decoded bytes or error with its offset
+   */
+  std::expected<Bytes, DecodeError> decode(std::string_view userData, const DecodeOptions& options);
+
+  /*! \brief internal helpers of container overloads
+   */
+  namespace detail {
+    /*!
+     * \brief leniencyOf
+     * \param options
+     * \return index of decode tables variant built for options
+     */
+    constexpr uint8_t leniencyOf(const DecodeOptions& options) {
+      return (options.ignoreCase ? gIgnoreCase : gStrict) | (options.skipAllWhitespaces ? gSkipAllWhitespaces : gStrict)
+             | (options.mapConfusables ? gMapConfusables : gStrict);
+    }
+
+    /*!
+     * \brief decodeError
+     *
+     * Locate the character decoding failed on, called only after an error
+     * \return error with its offset
+     */
+    DecodeError decodeError(std::string_view userData, Error error, const DecodeOptions& options,
+                            const CodecTables& tables);
+  }  // namespace detail
+
+  /*! \brief Callable fed with chunks of data as they are encoded, e.g. base32::Crc32c
+   */
+  template <typename Hasher>
+  concept ByteHasher = requires(Hasher& hasher, std::span<const uint8_t> chunk) { hasher(chunk); };
+
+  /*!
+   * \brief gHashChunkBytes
+   *
+   * Hashing encode functions feed hasher and kernels in chunks of this size, the chunk and its encoded
+   * characters stay in L1 cache between both passes
+   */
+  constexpr size_t gHashChunkBytes = 1638 * 5;
+
+  /*! \brief Contiguous resizable container of 1 byte elements, e.g. std::pmr::string or std::pmr::vector<uint8_t>
+   */
+  template <typename Container>
+  concept ByteContainer = std::ranges::contiguous_range<Container> && std::ranges::sized_range<Container>
+                          && sizeof(std::ranges::range_value_t<Container>) == 1
+                          && std::is_trivially_copyable_v<std::ranges::range_value_t<Container>>
+                          && requires(Container& container, size_t size) { container.resize(size); };
+
+  /*! \brief Encode bytes as base 32 string into any container
+   *
+   *  Content of output is replaced, its storage and allocator are reused, so encoded data may live
+   *  in a per-request arena:
+   *  \code
+   *  auto encoded = base32::encode(bytes, std::pmr::string(&arena));
+   *  \endcode
+   *
+   *  \param userData: max size is options.maxInputLength
+   *  \param output container to fill
+   *  \param options
+   *  \return output holding encoded string or error
+   */
+  template <ByteContainer Container>
+  std::expected<Container, Error> encode(std::span<const uint8_t> userData, Container output,
+                                         const EncodeOptions& options = {}) {
+    // over-limit input and saturated wrapped length are reported by encodeInto, output isn't resized for them
+    const size_t outputLength = detail::validateEncodeInput(userData, options.maxInputLength) == Error::NoError
+                                  ? encodedSize(userData.size(), options)
+                                  : gNoInputLimit;
+    if (outputLength != gNoInputLimit) {
+      output.resize(outputLength);
+    }
+    Error errCode{};
+    const size_t written = encodeInto(userData, std::span(reinterpret_cast<char*>(std::ranges::data(output)),
+                                                          std::ranges::size(output)),
+                                      errCode, options);
+    if (errCode != Error::NoError) [[unlikely]] {
+      return std::unexpected(errCode);
+    }
+    output.resize(written);
+
+    return output;
+  }
+
+  /*! \brief Decode base 32 string into any container
+   *
+   *  Content of output is replaced, its storage and allocator are reused. No partial output
+   *  is returned on error.
+   *
+   *  \param userData encoded base 32 string
+   *  \param output container to fill
+   *  \param options
+   *  \return output holding decoded bytes or error with its offset
+   */
+  template <ByteContainer Container>
+  std::expected<Container, DecodeError> decode(std::string_view userData, Container output,
+                                               const DecodeOptions& options = {}) {
+    // over-limit input is reported by decodeInto, output isn't resized for it
+    if (userData.size() <= options.maxInputLength) {
+      output.resize(maxDecodedSize(userData.size()));
+    }
+    Error errCode{};
+    const size_t written = decodeInto(userData, std::span(reinterpret_cast<uint8_t*>(std::ranges::data(output)),
+                                                          std::ranges::size(output)),
+                                      errCode, options);
+    if (errCode != Error::NoError) [[unlikely]] {
+      const auto& tables = detail::gRfc4648LenientTables[detail::leniencyOf(options)];
+      return std::unexpected(detail::decodeError(userData, errCode, options, tables));
+    }
+    output.resize(written);
+
+    return output;
+  }
+
+  /*! \brief Encode fixed number of bytes, e.g. a UUID or a digest
+   *
+   *  Sizes and padding are computed at compile time, blocks are encoded by unrolled code without
+   *  validation or allocation.
+   *
+   *  \param userData
+   *  \return base 32 characters with padding, not null terminated
+   */
+  template <size_t N>
+  std::array<char, encodedSize(N)> encode(const std::array<uint8_t, N>& userData) {
+    return detail::encodeFixed<Padding::Enabled>(userData, detail::gRfc4648Tables);
+  }
+
+  /*! \brief Decode base 32 string of fixed number of bytes, e.g. a UUID or a digest
+   *
+   *  Canonical input, with or without padding, is decoded by unrolled code without branches on characters.
+   *  Any other input is decoded as by decode and has to produce exactly N bytes.
+   *
+   *  \code
+   *  const auto uuid = base32::decode<16>(encoded);
+   *  \endcode
+   *
+   *  \param userData encoded base 32 string
+   *  \return N decoded bytes or error with its offset, InvalidB32Input at the end of input if it decodes to another number of bytes
+   */
+  template <size_t N>
+  std::expected<std::array<uint8_t, N>, DecodeError> decode(std::string_view userData) {
+    std::array<uint8_t, N> decoded;
+    if (detail::decodeFixed(userData, decoded, detail::gRfc4648Tables)) [[likely]] {
+      return decoded;
+    }
+
+    const auto result = decode(userData);
+    if (!result.has_value()) {
+      return std::unexpected(result.error());
+    }
+    if (result->size() != N) {
+      return std::unexpected(DecodeError{Error::InvalidB32Input, userData.size()});
+    }
+    std::ranges::copy(*result, decoded.begin());
+
+    return decoded;
+  }
+
+  /*! \brief Check that base 32 string decodes without errors
+   *
+   *  Scans input with active kernels without decoding or allocating.
+   *
+   *  \param userData encoded base 32 string
+   *  \return error decode would report
+   */
+  Error validate(std::string_view userData);
+
+  /*! \brief Check that base 32 string decodes without errors with custom settings
+   *
+   *  \param userData encoded base 32 string
+   *  \param options
+   *  \return error decode would report
+   */
+  Error validate(std::string_view userData, const DecodeOptions& options);
+
+  /*! \brief Exact length of decoded data
+   *
+   *  Unlike maxDecodedSize padding and whitespaces are taken into account, input is validated.
+   *
+   *  \param userData encoded base 32 string
+   *  \param errCode error decode would report
+   *  \return number of bytes produced by decode, 0 on error
+   */
+  size_t decodedSize(std::string_view userData, Error& errCode);
+
+  /*! \brief Exact length of decoded data with custom settings
+   *
+   *  \param userData encoded base 32 string
+   *  \param errCode error decode would report
+   *  \param options
+   *  \return number of bytes produced by decode, 0 on error
+   */
+  size_t decodedSize(std::string_view userData, Error& errCode, const DecodeOptions& options);
+
+  /*! \brief Compare decoded base 32 string with expected bytes without decoding into memory
+   *
+   *  Decodes block by block and accumulates differences, so time does not depend on content of expected
+   *  or on position of the first different byte. Intended for verification of secrets and tokens.
+   *
+   *  \param userData encoded base 32 string
+   *  \param expected bytes decode should produce
+   *  \return true if userData is valid and decodes to expected
+   */
+  bool decodedEquals(std::string_view userData, std::span<const uint8_t> expected);
+
+  /*! \brief Compare decoded base 32 string with expected bytes with custom settings
+   *
+   *  \param userData encoded base 32 string
+   *  \param expected bytes decode should produce
+   *  \param options
+   *  \return true if userData is valid and decodes to expected
+   */
+  bool decodedEquals(std::string_view userData, std::span<const uint8_t> expected, const DecodeOptions& options);
+
+  /*! \brief Backend used by encoding and decoding functions
+   *
+   *  \return active backend
+   */
+  Backend activeBackend();
+
+  /*! \brief Check if backend is compiled in and can run on current CPU
+   *
+   *  \param backend
+   *  \return true if backend can be selected
+   */
+  bool isBackendSupported(Backend backend);
+
+  /*! \brief Force backend for all subsequent calls, for testing and benchmarking
+   *
+   *  \param backend
+   *  \return false if backend is not supported, active backend is kept then
+   */
+  bool selectBackend(Backend backend);
+
+  /*! \brief Return to the fastest backend supported by current CPU
+   */
+  void resetBackend();
+
+  /*! \brief Incremental base 32 encoder
+   *
+   *  Input is accepted in chunks of any size, incomplete 5 bytes block is carried over between calls,
+   *  so there is no limit for the total size of encoded data.
+   */
+  class Encoder {
+  public:
+    /*! \brief Number of characters produced by update
+     *
+     *  \param chunkSize number of bytes passed to update
+     *  \return required output size
+     */
+    constexpr size_t updateSize(size_t chunkSize) const {
+      return (pendingCount_ + chunkSize) / 5 * 8;
+    }
+
+    /*! \brief Number of characters produced by finalize
+     *
+     *  \return required output size
+     */
+    constexpr size_t finalizeSize() const {
+      return pendingCount_ == 0 ? 0 : 8;
+    }
+
+    /*! \brief Encode next chunk of data
+     *
+     *  \param chunk
+     *  \param output at least updateSize(chunk.size()) characters
+     *  \param errCode BufferTooSmall if output can't hold encoded data, state is untouched then
+     *  \return number of characters written
+     */
+    size_t update(std::span<const uint8_t> chunk, std::span<char> output, Error& errCode);
+
+    /*! \brief Encode the rest of data with padding and reset encoder for the next stream
+     *
+     *  \param output at least finalizeSize() characters
+     *  \param errCode BufferTooSmall if output can't hold encoded data, state is untouched then
+     *  \return number of characters written
+     */
+    size_t finalize(std::span<char> output, Error& errCode);
+
+    /*! \brief Encode next chunk of data feeding hasher with the same data
+     *
+     *  Chunk is split into pieces of gHashChunkBytes, every piece is hashed and encoded while it is in cache.
+     *
+     *  \param chunk
+     *  \param output at least updateSize(chunk.size()) characters
+     *  \param errCode BufferTooSmall if output can't hold encoded data, state and hasher are untouched then
+     *  \param hasher called with every piece
+     *  \return number of characters written
+     */
+    template <ByteHasher Hasher>
+    size_t update(std::span<const uint8_t> chunk, std::span<char> output, Error& errCode, Hasher& hasher) {
+      if (output.size() < updateSize(chunk.size())) {
+        errCode = Error::BufferTooSmall;
+        return 0;
+      }
+
+      size_t written = 0;
+      errCode = Error::NoError;
+      for (size_t offset = 0; offset < chunk.size(); offset += gHashChunkBytes) {
+        const auto piece = chunk.subspan(offset, std::min(gHashChunkBytes, chunk.size() - offset));
+        hasher(piece);
+        written += update(piece, output.subspan(written), errCode);
+      }
+
+      return written;
+    }
+
+  private:
+    std::array<uint8_t, 4> pending_{};
+    uint8_t pendingCount_{0};
+  };
+
+  /*! \brief Incremental base 32 decoder
+   *
+   *  Input is accepted in chunks of any size, incomplete 8 characters block is carried over between calls,
+   *  so there is no limit for the total size of decoded data.
+   */
+  class Decoder {
+  public:
+    /*! \brief Max number of bytes produced by update
+     *
+     *  \param chunkSize number of characters passed to update
+     *  \return required output size
+     */
+    constexpr size_t updateSize(size_t chunkSize) const {
+      return (valuesCount_ + chunkSize) / 8 * 5;
+    }
+
+    /*! \brief Number of bytes produced by finalize
+     *
+     *  \return required output size
+     */
+    constexpr size_t finalizeSize() const {
+      return valuesCount_ * 5 / 8;
+    }
+
+    /*! \brief Decode next chunk of base 32 string
+     *
+     *  Whitespaces are skipped, once padding is met only padding and whitespaces are allowed.
+     *
+     *  \param chunk
+     *  \param output at least updateSize(chunk.size()) bytes
+     *  \param errCode InvalidB32Input on characters out of alphabet, decoder should be reset then
+     *  \return number of bytes written
+     */
+    size_t update(std::string_view chunk, std::span<uint8_t> output, Error& errCode);
+
+    /*! \brief Decode the rest of data and reset decoder for the next stream
+     *
+     *  \param output at least finalizeSize() bytes
+     *  \param errCode BufferTooSmall if output can't hold decoded data, state is untouched then
+     *  \return number of bytes written
+     */
+    size_t finalize(std::span<uint8_t> output, Error& errCode);
+
+    /*! \brief Drop carried over state, e.g. after an error
+     */
+    void reset();
+
+  private:
+    std::array<uint8_t, 8> values_{};
+    uint8_t valuesCount_{0};
+    bool padding_{false};
+  };
+
+  /*! \brief Encode chain of buffers into chain of buffers without flattening them
+   *
+   *  Inputs are encoded as one stream by Encoder, blocks are carried over input boundaries.
+   *  Output segments are filled in order, only a block crossing a segment boundary is staged
+   *  and copied in two parts. Output is padded as encode pads it.
+   *
+   *  \param inputs segments of data to encode
+   *  \param outputs segments of at least encodedSize of all inputs characters in total
+   *  \param errCode BufferTooSmall if outputs are too small, MaxLengthExceeded if encoded length of all
+   *  inputs doesn't fit size_t, nothing is written then
+   *  \return total number of characters written
+   */
+  size_t encodeSegments(std::span<const std::span<const uint8_t>> inputs, std::span<const std::span<char>> outputs,
+                        Error& errCode);
+
+  /*! \brief Decode chain of base 32 buffers into chain of buffers without flattening them
+   *
+   *  Inputs are decoded as one stream by Decoder, so whitespaces and padding follow its rules.
+   *  Output segments are filled in order, only a block crossing a segment boundary is staged
+   *  and copied in two parts.
+   *
+   *  \param inputs segments of base 32 string
+   *  \param outputs segments of decoded data, decodedSize of all inputs bytes in total is enough
+   *  \param errCode InvalidB32Input or BufferTooSmall, output holds bytes decoded before the error then
+   *  \return total number of bytes written
+   */
+  size_t decodeSegments(std::span<const std::string_view> inputs, std::span<const std::span<uint8_t>> outputs,
+                        Error& errCode);
 }  // namespace base32
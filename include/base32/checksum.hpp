@@ -0,0 +1,129 @@
+#pragma once
+#include "base32/base32.hpp"
+#include "base32/stats.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <string_view>
+
+namespace base32 {
+  /*! \brief internal checksum implementation
+   */
+  namespace detail {
+    /*!
+     * \brief crc32cUpdate
+     *
+     * Continue CRC-32C (Castagnoli) of data, with SSE 4.2 or ARMv8 CRC instructions where supported
+     * \param crc current register value, not inverted
+     * \param data
+     * \return new register value
+     */
+    uint32_t crc32cUpdate(uint32_t crc, std::span<const uint8_t> data);
+
+    /*!
+     * \brief hashChunkBytes
+     *
+     * Chunks of wrapped output end at end of line, so every chunk is wrapped on its own
+     * \param options
+     * \param inputSize
+     * \return number of bytes hashed and encoded at once, whole input if a line is longer than a chunk
+     */
+    constexpr size_t hashChunkBytes(const EncodeOptions& options, size_t inputSize) {
+      if (options.lineWidth == 0) {
+        return gHashChunkBytes;
+      }
+      constexpr size_t chunkBlocks = gHashChunkBytes / gBytesPerB32Block;
+      if (options.lineWidth > chunkBlocks * gCharsPerB32Block) {
+        return inputSize;
+      }
+
+      const size_t lineBlocks = std::lcm(options.lineWidth, size_t{gCharsPerB32Block}) / gCharsPerB32Block;
+
+      return std::max<size_t>(chunkBlocks / lineBlocks, 1) * lineBlocks * gBytesPerB32Block;
+    }
+  }  // namespace detail
+
+  /*! \brief CRC-32C checksum usable as hasher of encoding functions
+   *
+   *  \code
+   *  base32::Crc32c crc;
+   *  base32::encodeIntoHashed(bytes, output, err, crc);
+   *  const uint32_t checksum = crc.value();
+   *  \endcode
+   */
+  class Crc32c {
+  public:
+    void operator()(std::span<const uint8_t> chunk) {
+      crc_ = detail::crc32cUpdate(crc_, chunk);
+    }
+
+    /*! \brief Checksum of all data passed so far
+     */
+    [[nodiscard]] uint32_t value() const {
+      return ~crc_;
+    }
+
+  private:
+    uint32_t crc_{0xFFFFFFFF};
+  };
+
+  /*! \brief Encode bytes into caller provided buffer feeding hasher in the same pass
+   *
+   *  Input is encoded in chunks of gHashChunkBytes, each chunk is hashed right before it is encoded,
+   *  so the data is loaded from memory once. Chunks are encoded by one thread, wrapped output is split
+   *  into chunks of whole lines.
+   *
+   *  \param userData: max size is options.maxInputLength
+   *  \param output buffer of at least encodedSize(userData.size(), options) characters
+   *  \param errCode BufferTooSmall if output can't hold encoded data, hasher is not called on errors
+   *  \param hasher called with consecutive chunks of userData
+   *  \param options
+   *  \return number of characters written
+   */
+  template <ByteHasher Hasher>
+  size_t encodeIntoHashed(std::span<const uint8_t> userData, std::span<char> output, Error& errCode, Hasher& hasher,
+                          const EncodeOptions& options = {}) {
+    detail::StatsScope stats(Operation::Encode, userData.size(), errCode);
+    if (const Error error = detail::validateEncodeInput(userData, options.maxInputLength); error != Error::NoError) {
+      errCode = error;
+      return 0;
+    }
+    // wrapped length saturates when line separators don't fit size_t
+    const size_t outputLength = encodedSize(userData.size(), options);
+    if (outputLength == gNoInputLimit) {
+      errCode = Error::MaxLengthExceeded;
+      return 0;
+    }
+    if (output.size() < outputLength) {
+      errCode = Error::BufferTooSmall;
+      return 0;
+    }
+
+    // chunks are whole blocks, so only the last one has a tail and padding, and whole lines of wrapped output,
+    // so chunks are followed by separator except the last one
+    EncodeOptions chunkOptions = options;
+    chunkOptions.threads = 1;
+    chunkOptions.maxInputLength = gNoInputLimit;
+    const size_t chunkBytes = detail::hashChunkBytes(options, userData.size());
+    const std::string_view separator = options.lineWidth != 0 ? options.lineSeparator : std::string_view();
+    const size_t chunkStride = detail::wrappedSize(chunkBytes / detail::gBytesPerB32Block * detail::gCharsPerB32Block,
+                                                   options)
+                               + separator.size();
+    errCode = Error::NoError;
+    for (size_t offset = 0; offset < userData.size() && errCode == Error::NoError; offset += chunkBytes) {
+      const auto chunk = userData.subspan(offset, std::min(chunkBytes, userData.size() - offset));
+      const auto chunkOutput = output.subspan(offset / chunkBytes * chunkStride);
+      hasher(chunk);
+      const size_t written = encodeInto(chunk, chunkOutput, errCode, chunkOptions);
+      if (offset + chunk.size() < userData.size()) {
+        std::ranges::copy(separator, chunkOutput.data() + written);
+      }
+    }
+    stats.setBytesOut(outputLength);
+
+    return outputLength;
+  }
+}  // namespace base32
@@ -0,0 +1,503 @@
+#pragma once
+#include "base32/base32.hpp"
+#include "base32/stats.hpp"
+#include "base32/tables.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace base32 {
+  /*!
+   * \brief RFC 4648 §6 alphabet, used by free functions
+   */
+  struct Rfc4648Alphabet {
+    static constexpr std::string_view gChars = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+  };
+
+  /*!
+   * \brief RFC 4648 §7 "Extended Hex" alphabet, encoded data keeps its sort order
+   */
+  struct Base32HexAlphabet {
+    static constexpr std::string_view gChars = "0123456789ABCDEFGHIJKLMNOPQRSTUV";
+  };
+
+  /*!
+   * \brief Douglas Crockford's alphabet, excludes I, L, O and U
+   */
+  struct CrockfordAlphabet {
+    static constexpr std::string_view gChars = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+  };
+
+  /*!
+   * \brief z-base-32 alphabet, lowercase and permuted for human use
+   */
+  struct ZBase32Alphabet {
+    static constexpr std::string_view gChars = "ybndrfg8ejkmcpqxot1uwisza345h769";
+  };
+
+  /*! \brief internal entry points shared by all codecs
+   */
+  namespace detail {
+    /*!
+     * \brief encodeInto
+     *
+     * Implementation of base32::encodeInto for any alphabet
+     * \param output buffer of at least encodedSize(userData.size(), padding) characters
+     */
+    size_t encodeInto(std::span<const uint8_t> userData, std::span<char> output, Error& errCode,
+                      const EncodeOptions& options, const CodecTables& tables, Padding padding);
+
+    /*!
+     * \brief decodeInto
+     *
+     * Implementation of base32::decodeInto for any alphabet
+     * \param output buffer of at least maxDecodedSize(userData.size()) bytes
+     */
+    size_t decodeInto(std::string_view userData, std::span<uint8_t> output, Error& errCode,
+                      const DecodeOptions& options, const CodecTables& tables);
+
+    /*!
+     * \brief decodeInPlace
+     *
+     * Implementation of base32::decodeInPlace for any alphabet
+     */
+    std::span<uint8_t> decodeInPlace(std::span<char> buffer, Error& errCode, const DecodeOptions& options,
+                                     const CodecTables& tables);
+
+    /*!
+     * \brief decode
+     *
+     * Implementation of base32::decode returning std::expected for any alphabet
+     */
+    std::expected<Bytes, DecodeError> decode(std::string_view userData, const DecodeOptions& options,
+                                             const CodecTables& tables);
+
+    /*!
+     * \brief decodedSize
+     *
+     * Implementation of base32::decodedSize for any alphabet
+     */
+    size_t decodedSize(std::string_view userData, Error& errCode, const DecodeOptions& options,
+                       const CodecTables& tables);
+
+    /*!
+     * \brief decodedEquals
+     *
+     * Implementation of base32::decodedEquals for any alphabet
+     */
+    bool decodedEquals(std::string_view userData, std::span<const uint8_t> expected, const DecodeOptions& options,
+                       const CodecTables& tables);
+  }  // namespace detail
+
+  /*! \brief Base 32 codec over a compile time alphabet
+   *
+   *  Lookup tables of every alphabet are built at compile time, all codecs share the same
+   *  SIMD kernels. Decoding accepts input with or without padding, lenient decoding selects
+   *  another table so it runs at the same speed.
+   *
+   *  \tparam Alphabet type with static constexpr std::string_view gChars of 32 characters
+   *  \tparam padding whether encoded strings end with '='
+   */
+  template <typename Alphabet, Padding padding = Padding::Enabled>
+  class BasicCodec {
+  public:
+    /*! \brief Exact length of encoded string
+     */
+    static constexpr size_t encodedSize(size_t bytesCount) {
+      return base32::encodedSize(bytesCount, padding);
+    }
+
+    /*! \brief Exact length of encoded string, line separators of options included
+     */
+    static constexpr size_t encodedSize(size_t bytesCount, const EncodeOptions& options) {
+      return detail::wrappedSize(encodedSize(bytesCount), options);
+    }
+
+    /*! \brief Encode bytes into caller provided buffer
+     *
+     *  \param output buffer of at least encodedSize(userData.size(), options) characters
+     *  \return number of characters written
+     */
+    static size_t encodeInto(std::span<const uint8_t> userData, std::span<char> output, Error& errCode,
+                             const EncodeOptions& options = {}) {
+      return detail::encodeInto(userData, output, errCode, options, gTables[detail::gStrict], padding);
+    }
+
+    /*! \brief Decode base 32 string into caller provided buffer
+     *
+     *  \param output buffer of at least maxDecodedSize(userData.size()) bytes
+     *  \return number of bytes written
+     */
+    static size_t decodeInto(std::string_view userData, std::span<uint8_t> output, Error& errCode,
+                             const DecodeOptions& options = {}) {
+      return detail::decodeInto(userData, output, errCode, options, gTables[detail::leniencyOf(options)]);
+    }
+
+    /*! \brief Decode base 32 string overwriting it with decoded bytes
+     *
+     *  \return decoded bytes at the front of buffer
+     */
+    static std::span<uint8_t> decodeInPlace(std::span<char> buffer, Error& errCode, const DecodeOptions& options = {}) {
+      return detail::decodeInPlace(buffer, errCode, options, gTables[detail::leniencyOf(options)]);
+    }
+
+    /*! \brief Decode base 32 string, no partial output is returned on error
+     *
+     *  \return decoded bytes or error with offset of the character decoding failed on
+     */
+    static std::expected<Bytes, DecodeError> decode(std::string_view userData, const DecodeOptions& options = {}) {
+      return detail::decode(userData, options, gTables[detail::leniencyOf(options)]);
+    }
+
+    /*! \brief Encode bytes into any container, its storage and allocator are reused
+     */
+    template <ByteContainer Container>
+    static std::expected<Container, Error> encode(std::span<const uint8_t> userData, Container output,
+                                                  const EncodeOptions& options = {}) {
+      // over-limit input and saturated wrapped length are reported by encodeInto, output isn't resized for them
+      const size_t outputLength = detail::validateEncodeInput(userData, options.maxInputLength) == Error::NoError
+                                    ? encodedSize(userData.size(), options)
+                                    : gNoInputLimit;
+      if (outputLength != gNoInputLimit) {
+        output.resize(outputLength);
+      }
+      Error errCode{};
+      const size_t written = encodeInto(userData, std::span(reinterpret_cast<char*>(std::ranges::data(output)),
+                                                            std::ranges::size(output)),
+                                        errCode, options);
+      if (errCode != Error::NoError) [[unlikely]] {
+        return std::unexpected(errCode);
+      }
+      output.resize(written);
+
+      return output;
+    }
+
+    /*! \brief Decode base 32 string into any container, no partial output is returned on error
+     */
+    template <ByteContainer Container>
+    static std::expected<Container, DecodeError> decode(std::string_view userData, Container output,
+                                                        const DecodeOptions& options = {}) {
+      // over-limit input is reported by decodeInto, output isn't resized for it
+      if (userData.size() <= options.maxInputLength) {
+        output.resize(maxDecodedSize(userData.size()));
+      }
+      Error errCode{};
+      const size_t written = decodeInto(userData, std::span(reinterpret_cast<uint8_t*>(std::ranges::data(output)),
+                                                            std::ranges::size(output)),
+                                        errCode, options);
+      if (errCode != Error::NoError) [[unlikely]] {
+        return std::unexpected(detail::decodeError(userData, errCode, options, gTables[detail::leniencyOf(options)]));
+      }
+      output.resize(written);
+
+      return output;
+    }
+
+    /*! \brief Check that base 32 string decodes without errors
+     *
+     *  \return error decode would report
+     */
+    static Error validate(std::string_view userData, const DecodeOptions& options = {}) {
+      Error errCode{};
+      detail::decodedSize(userData, errCode, options, gTables[detail::leniencyOf(options)]);
+
+      return errCode;
+    }
+
+    /*! \brief Exact length of decoded data, 0 on error
+     */
+    static size_t decodedSize(std::string_view userData, Error& errCode, const DecodeOptions& options = {}) {
+      return detail::decodedSize(userData, errCode, options, gTables[detail::leniencyOf(options)]);
+    }
+
+    /*! \brief Compare decoded base 32 string with expected bytes in time independent of their content
+     */
+    static bool decodedEquals(std::string_view userData, std::span<const uint8_t> expected,
+                              const DecodeOptions& options = {}) {
+      return detail::decodedEquals(userData, expected, options, gTables[detail::leniencyOf(options)]);
+    }
+
+    /*! \brief Encode bytes as base 32 string
+     */
+    static std::string encode(std::span<const uint8_t> userData, Error& errCode, const EncodeOptions& options = {}) {
+      detail::StatsScope stats(Operation::Encode, userData.size(), errCode);
+      if (const Error error = detail::validateEncodeInput(userData, options.maxInputLength);
+          error != Error::NoError) {
+        errCode = error;
+        return {};
+      }
+
+      // wrapped length saturates when line separators don't fit size_t
+      const size_t outputLength = encodedSize(userData.size(), options);
+      if (outputLength == gNoInputLimit) {
+        errCode = Error::MaxLengthExceeded;
+        return {};
+      }
+      std::string encodedData(outputLength, '\0');
+      encodedData.resize(encodeInto(userData, encodedData, errCode, options));
+      stats.setBytesOut(encodedData.size());
+
+      return encodedData;
+    }
+
+    /*! \brief Decode base 32 string, decoded bytes up to the first error are returned on failure
+     */
+    static Bytes decode(std::string_view userData, Error& errCode, const DecodeOptions& options = {}) {
+      detail::StatsScope stats(Operation::Decode, userData.size(), errCode);
+      if (userData.size() > options.maxInputLength) {
+        errCode = Error::MaxLengthExceeded;
+        return {};
+      }
+
+      Bytes decodedData(maxDecodedSize(userData.size()));
+      decodedData.resize(decodeInto(userData, decodedData, errCode, options));
+      stats.setBytesOut(decodedData.size());
+
+      return decodedData;
+    }
+
+    /*! \brief Encode fixed number of bytes with unrolled code
+     */
+    template <size_t N>
+    static std::array<char, base32::encodedSize(N, padding)> encode(const std::array<uint8_t, N>& userData) {
+      return detail::encodeFixed<padding>(userData, gTables[detail::gStrict]);
+    }
+
+    /*! \brief Decode base 32 string of fixed number of bytes, canonical input is decoded by unrolled code
+     *
+     *  \return N decoded bytes or error with its offset
+     */
+    template <size_t N>
+    static std::expected<std::array<uint8_t, N>, DecodeError> decode(std::string_view userData) {
+      std::array<uint8_t, N> decoded;
+      if (detail::decodeFixed(userData, decoded, gTables[detail::gStrict])) [[likely]] {
+        return decoded;
+      }
+
+      const auto result = decode(userData);
+      if (!result.has_value()) {
+        return std::unexpected(result.error());
+      }
+      if (result->size() != N) {
+        return std::unexpected(DecodeError{Error::InvalidB32Input, userData.size()});
+      }
+      std::ranges::copy(*result, decoded.begin());
+
+      return decoded;
+    }
+
+    /*! \brief Encode bytes at compile time
+     */
+    template <size_t N>
+    static constexpr std::array<char, base32::encodedSize(N, padding)> encodeArray(const std::array<uint8_t, N>& userData) {
+      std::array<char, base32::encodedSize(N, padding)> encoded{};
+      detail::encodeConstexpr(userData, encoded, gTables[detail::gStrict], padding);
+
+      return encoded;
+    }
+
+    /*! \brief Decode base 32 literal at compile time, invalid input does not compile
+     */
+    template <Literal Encoded>
+    static consteval auto decodeArray() {
+      constexpr const detail::CodecTables& tables = gTables[detail::gStrict];
+      constexpr size_t decodedSize = maxDecodedSize(detail::payloadCharsConstexpr(Encoded.view(), tables));
+      std::array<uint8_t, decodedSize> decoded{};
+      size_t written = 0;
+      if (detail::decodeConstexpr(Encoded.view(), decoded, written, tables) != Error::NoError) {
+        detail::invalidBase32Literal();
+      }
+
+      return decoded;
+    }
+
+  private:
+    friend class Codec;
+
+    static constexpr std::array<detail::CodecTables, detail::gLeniencyVariants> gTables =
+      detail::buildLenientTables(Alphabet::gChars);
+  };
+
+  /*!
+   * \brief RFC 4648 base32, same as free functions
+   */
+  using Rfc4648Codec = BasicCodec<Rfc4648Alphabet>;
+
+  /*!
+   * \brief RFC 4648 base32hex
+   */
+  using Base32HexCodec = BasicCodec<Base32HexAlphabet>;
+
+  /*!
+   * \brief Crockford's base32, without padding
+   */
+  using CrockfordCodec = BasicCodec<CrockfordAlphabet, Padding::Disabled>;
+
+  /*!
+   * \brief z-base-32, without padding
+   */
+  using ZBase32Codec = BasicCodec<ZBase32Alphabet, Padding::Disabled>;
+
+  /*! \brief Codec with settings chosen at run time and reusable output storage
+   *
+   *  Tables of the alphabet and leniency are resolved at construction. Results are views into storage
+   *  of the codec which grows to the largest result and is reused, so repeated calls of one thread don't
+   *  allocate. A view is valid until the next call. Not thread safe, every thread keeps its own codec.
+   *  The line separator of encode options is copied into the codec.
+   *
+   *  \code
+   *  base32::Codec codec(base32::CrockfordAlphabet{}, {.padding = base32::Padding::Disabled});
+   *  const std::string_view encoded = codec.encode(bytes, err);
+   *  \endcode
+   */
+  class Codec {
+  public:
+    /*! \brief RFC 4648 codec
+     */
+    explicit Codec(const EncodeOptions& encodeOptions = {}, const DecodeOptions& decodeOptions = {})
+        : Codec(Rfc4648Alphabet{}, encodeOptions, decodeOptions) {}
+
+    /*! \brief Codec of an alphabet, e.g. base32::Base32HexAlphabet{}
+     *
+     *  \param encodeOptions padding of encoding is encodeOptions.padding
+     *  \param decodeOptions leniency of decoding
+     */
+    template <typename Alphabet>
+    explicit Codec(Alphabet /*alphabet*/, const EncodeOptions& encodeOptions = {}, const DecodeOptions& decodeOptions = {})
+        : lineSeparator_(encodeOptions.lineSeparator),
+          encodeOptions_(withSeparator(encodeOptions, lineSeparator_)),
+          decodeOptions_(decodeOptions),
+          encodeTables_(&BasicCodec<Alphabet>::gTables[detail::gStrict]),
+          decodeTables_(&BasicCodec<Alphabet>::gTables[detail::leniencyOf(decodeOptions)]) {}
+
+    // encodeOptions_.lineSeparator views lineSeparator_ of the same codec
+    Codec(const Codec& other)
+        : lineSeparator_(other.lineSeparator_),
+          encodeOptions_(withSeparator(other.encodeOptions_, lineSeparator_)),
+          decodeOptions_(other.decodeOptions_),
+          encodeTables_(other.encodeTables_),
+          decodeTables_(other.decodeTables_),
+          chars_(other.chars_),
+          bytes_(other.bytes_) {}
+
+    Codec(Codec&& other) noexcept
+        : lineSeparator_(std::move(other.lineSeparator_)),
+          encodeOptions_(withSeparator(other.encodeOptions_, lineSeparator_)),
+          decodeOptions_(other.decodeOptions_),
+          encodeTables_(other.encodeTables_),
+          decodeTables_(other.decodeTables_),
+          chars_(std::move(other.chars_)),
+          bytes_(std::move(other.bytes_)) {
+      other.encodeOptions_.lineSeparator = other.lineSeparator_;
+    }
+
+    Codec& operator=(const Codec& other) {
+      if (this != &other) {
+        *this = Codec(other);
+      }
+
+      return *this;
+    }
+
+    Codec& operator=(Codec&& other) noexcept {
+      if (this != &other) {
+        lineSeparator_ = std::move(other.lineSeparator_);
+        encodeOptions_ = withSeparator(other.encodeOptions_, lineSeparator_);
+        decodeOptions_ = other.decodeOptions_;
+        encodeTables_ = other.encodeTables_;
+        decodeTables_ = other.decodeTables_;
+        chars_ = std::move(other.chars_);
+        bytes_ = std::move(other.bytes_);
+        other.encodeOptions_.lineSeparator = other.lineSeparator_;
+      }
+
+      return *this;
+    }
+
+    ~Codec() = default;
+
+    /*! \brief Encode bytes into storage of the codec
+     *
+     *  \param userData: max size is encodeOptions().maxInputLength
+     *  \param errCode
+     *  \return encoded characters, empty on error
+     */
+    std::string_view encode(std::span<const uint8_t> userData, Error& errCode) {
+      detail::StatsScope stats(Operation::Encode, userData.size(), errCode);
+      if (const Error error = detail::validateEncodeInput(userData, encodeOptions_.maxInputLength);
+          error != Error::NoError) {
+        errCode = error;
+        return {};
+      }
+
+      // wrapped length saturates when line separators don't fit size_t
+      const size_t outputLength = base32::encodedSize(userData.size(), encodeOptions_);
+      if (outputLength == gNoInputLimit) {
+        errCode = Error::MaxLengthExceeded;
+        return {};
+      }
+      if (chars_.size() < outputLength) {
+        chars_.resize(outputLength);
+      }
+      const size_t written = detail::encodeInto(userData, chars_, errCode, encodeOptions_, *encodeTables_,
+                                                encodeOptions_.padding);
+      stats.setBytesOut(written);
+
+      return {chars_.data(), written};
+    }
+
+    /*! \brief Decode base 32 string into storage of the codec
+     *
+     *  \param userData encoded base 32 string, max size is decodeOptions().maxInputLength
+     *  \param errCode
+     *  \return decoded bytes, bytes decoded before the error on InvalidB32Input
+     */
+    std::span<const uint8_t> decode(std::string_view userData, Error& errCode) {
+      detail::StatsScope stats(Operation::Decode, userData.size(), errCode);
+      if (userData.size() > decodeOptions_.maxInputLength) {
+        errCode = Error::MaxLengthExceeded;
+        return {};
+      }
+
+      const size_t outputLength = maxDecodedSize(userData.size());
+      if (bytes_.size() < outputLength) {
+        bytes_.resize(outputLength);
+      }
+      const size_t written = detail::decodeInto(userData, bytes_, errCode, decodeOptions_, *decodeTables_);
+      stats.setBytesOut(written);
+
+      return std::span<const uint8_t>(bytes_).first(written);
+    }
+
+    const EncodeOptions& encodeOptions() const {
+      return encodeOptions_;
+    }
+
+    const DecodeOptions& decodeOptions() const {
+      return decodeOptions_;
+    }
+
+  private:
+    static EncodeOptions withSeparator(EncodeOptions options, std::string_view separator) {
+      options.lineSeparator = separator;
+      return options;
+    }
+
+    // owned copy of the separator, options given to the constructor may view a temporary
+    std::string lineSeparator_;
+    EncodeOptions encodeOptions_;
+    DecodeOptions decodeOptions_;
+    const detail::CodecTables* encodeTables_;
+    const detail::CodecTables* decodeTables_;
+    std::vector<char> chars_;
+    Bytes bytes_;
+  };
+}  // namespace base32
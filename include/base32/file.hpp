@@ -0,0 +1,35 @@
+#pragma once
+#include "base32/base32.hpp"
+
+#include <filesystem>
+
+namespace base32 {
+  /*! \brief Encode file as base 32 text file
+   *
+   *  Input is memory mapped and encoded in block aligned chunks straight into memory mapped output,
+   *  sized up front with encodedSize. Files of any size are accepted, options.maxInputLength is ignored,
+   *  chunks are split between threads as options say. Wrapped output is encoded in chunks of whole lines.
+   *
+   *  \param input path of file to encode
+   *  \param output path of file to create or overwrite, other than input
+   *  \param options
+   *  \return IoError if a file can't be read or written or output is the input file, MaxLengthExceeded if
+   *          encoded length doesn't fit size_t, output isn't created then
+   */
+  Error encodeFile(const std::filesystem::path& input, const std::filesystem::path& output,
+                   const EncodeOptions& options = {});
+
+  /*! \brief Decode base 32 text file
+   *
+   *  Input is memory mapped and validated as decodedSize does first, so output is created only for valid input
+   *  and sized up front. Decoding goes in block aligned chunks straight into memory mapped output.
+   *  Files of any size are accepted, options.maxInputLength is ignored.
+   *
+   *  \param input path of file to decode
+   *  \param output path of file to create or overwrite, other than input
+   *  \param options
+   *  \return decoding error or IoError if a file can't be read or written or output is the input file
+   */
+  Error decodeFile(const std::filesystem::path& input, const std::filesystem::path& output,
+                   const DecodeOptions& options = {});
+}  // namespace base32
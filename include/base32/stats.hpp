@@ -0,0 +1,192 @@
+#pragma once
+#include "base32/base32.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(BASE32_ENABLE_STATS)
+#  include <chrono>
+#endif
+
+namespace base32 {
+  /*!
+   * \brief Kinds of calls counted by statistics
+   */
+  enum class Operation: uint8_t {
+    Encode = 0,
+    Decode,
+    Validate,
+    Compare,
+    EncodeBatch,
+    DecodeBatch
+  };
+
+  constexpr size_t gOperationsCount = static_cast<size_t>(Operation::DecodeBatch) + 1;
+  constexpr size_t gBackendsCount = static_cast<size_t>(Backend::Neon) + 1;
+  constexpr size_t gErrorsCount = static_cast<size_t>(Error::IoError) + 1;
+
+  /*!
+   * \brief number of latency histogram buckets
+   *
+   * Bucket k counts calls shorter than gLatencyBucketBaseNs << k nanoseconds, the last one counts the rest
+   */
+  constexpr size_t gLatencyBuckets = 20;
+  constexpr uint64_t gLatencyBucketBaseNs = 64;
+
+  /*!
+   * \brief Counters of one operation on one backend
+   */
+  struct OperationStats {
+    uint64_t calls{0};
+
+    /*!
+     * \brief bytes to encode or characters to decode
+     */
+    uint64_t bytesIn{0};
+
+    /*!
+     * \brief characters or bytes written
+     */
+    uint64_t bytesOut{0};
+
+    /*!
+     * \brief calls by resulting error, NoError included
+     */
+    std::array<uint64_t, gErrorsCount> errors{};
+
+    std::array<uint64_t, gLatencyBuckets> latency{};
+  };
+
+  /*!
+   * \brief Snapshot of all counters, indexed by Backend and Operation
+   */
+  struct Stats {
+    std::array<std::array<OperationStats, gOperationsCount>, gBackendsCount> counters{};
+
+    [[nodiscard]] const OperationStats& of(Backend backend, Operation operation) const {
+      return counters[static_cast<size_t>(backend)][static_cast<size_t>(operation)];
+    }
+  };
+
+  /*! \brief Check if statistics are compiled in
+   *
+   *  Counting is off unless the library is built with BASE32_ENABLE_STATS, calls pay nothing for it then.
+   *  When on, every call of encode, decode, validate, decodedSize, decodedEquals and batch functions
+   *  updates relaxed atomic counters and reads steady clock twice. A call is counted once however many
+   *  chunks it processes, views and streaming Encoder and Decoder are not counted.
+   *
+   *  \return true if calls are counted
+   */
+  bool statsEnabled();
+
+  /*! \brief Copy of counters, consistent per counter but not across them
+   *
+   *  \return all zeroes if statistics are not compiled in
+   */
+  Stats statsSnapshot();
+
+  /*! \brief Set all counters to zero
+   */
+  void resetStats();
+
+  namespace detail {
+    /*!
+     * \brief recordCall
+     *
+     * Add one call of active backend to counters
+     * \param operation
+     * \param bytesIn
+     * \param bytesOut
+     * \param errCode
+     * \param nanoseconds duration of call
+     */
+    void recordCall(Operation operation, size_t bytesIn, size_t bytesOut, Error errCode, uint64_t nanoseconds);
+
+    /*!
+     * \brief enterStatsScope
+     * \return true if no other scope is open on this thread
+     */
+    bool enterStatsScope();
+
+    void leaveStatsScope();
+
+    /*!
+     * \brief The StatsScope class
+     *
+     * Records call when leaving scope, with error referenced at construction. Only the outermost scope of a thread
+     * records, so a public call is counted once however many chunks it encodes. Empty unless BASE32_ENABLE_STATS
+     * is defined.
+     */
+    class StatsScope {
+    public:
+#if defined(BASE32_ENABLE_STATS)
+      StatsScope(Operation operation, size_t bytesIn, const Error& errCode)
+          : operation_(operation), bytesIn_(bytesIn), errCode_(errCode), outermost_(enterStatsScope()),
+            start_(std::chrono::steady_clock::now()) {}
+
+      ~StatsScope() {
+        leaveStatsScope();
+        if (!outermost_) {
+          return;
+        }
+        const auto duration = std::chrono::steady_clock::now() - start_;
+        recordCall(operation_, bytesIn_, bytesOut_, errCode_,
+                   static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+      }
+
+      void setBytesIn(size_t bytesIn) {
+        bytesIn_ = bytesIn;
+      }
+
+      void setBytesOut(size_t bytesOut) {
+        bytesOut_ = bytesOut;
+      }
+#else
+      StatsScope(Operation /*operation*/, size_t /*bytesIn*/, const Error& /*errCode*/) {}
+
+      void setBytesIn(size_t /*bytesIn*/) {}
+
+      void setBytesOut(size_t /*bytesOut*/) {}
+#endif
+
+      StatsScope(const StatsScope&) = delete;
+      StatsScope& operator=(const StatsScope&) = delete;
+
+    private:
+#if defined(BASE32_ENABLE_STATS)
+      Operation operation_;
+      size_t bytesIn_;
+      size_t bytesOut_{0};
+      const Error& errCode_;
+      bool outermost_;
+      std::chrono::steady_clock::time_point start_;
+#endif
+    };
+
+    /*!
+     * \brief The UncountedScope class
+     *
+     * Calls made during its lifetime are not counted, e.g. chunks encoded by a lazy view
+     */
+    class UncountedScope {
+    public:
+#if defined(BASE32_ENABLE_STATS)
+      UncountedScope() {
+        enterStatsScope();
+      }
+
+      ~UncountedScope() {
+        leaveStatsScope();
+      }
+#else
+      // user provided, so an unused scope is not warned about
+      // NOLINTNEXTLINE(modernize-use-equals-default)
+      UncountedScope() {}
+#endif
+
+      UncountedScope(const UncountedScope&) = delete;
+      UncountedScope& operator=(const UncountedScope&) = delete;
+    };
+  }  // namespace detail
+}  // namespace base32
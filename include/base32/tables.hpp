@@ -0,0 +1,184 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/*! \brief lookup tables of base 32 alphabets
+ *
+ *  Tables are built at compile time and shared by runtime kernels and constexpr functions
+ */
+namespace base32::detail {
+  constexpr uint8_t gBitsPerByte = 8;
+  constexpr uint8_t gBytesPerB32Block = 5;
+  constexpr uint8_t gBitsPerB32Block = gBitsPerByte*gBytesPerB32Block;
+  constexpr uint8_t gBitsPerB32Char = 5;
+  constexpr uint8_t gCharsPerB32Block = 8;
+
+  constexpr uint8_t gB32AlphabetSize = 32;
+  constexpr uint16_t gB32CharPairs = 1024;
+  constexpr uint16_t gDecodeTableSize = 256;
+
+  /*!
+   * \brief gInvalidChar
+   *
+   * decode table marker of characters out of base 32 alphabet
+   */
+  constexpr uint8_t gInvalidChar = 0xFF;
+
+  /*!
+   * \brief gSkipChar
+   *
+   * decode table marker of characters ignored while decoding
+   */
+  constexpr uint8_t gSkipChar = 0xFE;
+
+  /*!
+   * \brief CodecTables
+   *
+   * all lookup tables of one base 32 alphabet
+   */
+  struct CodecTables {
+    std::array<char, gB32AlphabetSize> alphabet;
+
+    /*!
+     * \brief pairs
+     *
+     * every 10 bits value mapped to 2 base 32 characters, halves the number of lookups while encoding
+     */
+    std::array<std::array<char, 2>, gB32CharPairs> pairs;
+
+    /*!
+     * \brief decode
+     *
+     * position in base 32 alphabet for every possible char, or a marker if char is not a part of payload.
+     * Any value above 31 is not a position, so validity and position are checked with a single lookup.
+     */
+    std::array<uint8_t, gDecodeTableSize> decode;
+  };
+
+  /*!
+   * \brief leniency flags of decode tables
+   *
+   * Every combination of flags gets its own decode table, so lenient input is decoded as fast as
+   * strict one
+   */
+  constexpr uint8_t gStrict = 0;
+  constexpr uint8_t gIgnoreCase = 1;
+  constexpr uint8_t gSkipAllWhitespaces = 2;
+  constexpr uint8_t gMapConfusables = 4;
+  constexpr uint8_t gLeniencyVariants = 8;
+
+  /*!
+   * \brief isLetter
+   * \param chr ASCII character
+   */
+  constexpr bool isLetter(char chr) {
+    return (chr >= 'A' && chr <= 'Z') || (chr >= 'a' && chr <= 'z');
+  }
+
+  /*!
+   * \brief otherCase
+   * \param chr ASCII letter
+   * \return lowercase letter for uppercase one and vice versa
+   */
+  constexpr char otherCase(char chr) {
+    constexpr char caseBit = 'a' - 'A';
+
+    return static_cast<char>(chr ^ caseBit);
+  }
+
+  /*!
+   * \brief buildCodecTables
+   *
+   * Space is always skipped while decoding.
+   * With gIgnoreCase letters out of alphabet decode as the other case letter of alphabet.
+   * With gSkipAllWhitespaces tabs and line breaks are skipped as well.
+   * With gMapConfusables O decodes as 0 and I, L as 1 and hyphens are skipped as Crockford's base 32
+   * specifies, only for alphabets of none of these letters in either case, e.g. not for z-base-32.
+   *
+   * \param alphabet 32 characters
+   * \param leniency combination of leniency flags
+   * \return lookup tables
+   */
+  constexpr CodecTables buildCodecTables(std::string_view alphabet, uint8_t leniency = gStrict) {
+    CodecTables tables{};
+    for (uint8_t i = 0; i < gB32AlphabetSize; ++i) {
+      tables.alphabet.at(i) = alphabet.at(i);
+    }
+
+    for (size_t i = 0; i < gB32CharPairs; ++i) {
+      tables.pairs.at(i) = {tables.alphabet.at(i >> gBitsPerB32Char), tables.alphabet.at(i & 0x1F)};
+    }
+
+    tables.decode.fill(gInvalidChar);
+    for (uint8_t i = 0; i < gB32AlphabetSize; ++i) {
+      tables.decode.at(static_cast<uint8_t>(tables.alphabet.at(i))) = i;
+    }
+
+    const auto mapChar = [&tables](char chr, uint8_t value) {
+      if (tables.decode.at(static_cast<uint8_t>(chr)) == gInvalidChar) {
+        tables.decode.at(static_cast<uint8_t>(chr)) = value;
+      }
+    };
+
+    if ((leniency & gIgnoreCase) != 0) {
+      for (uint8_t i = 0; i < gB32AlphabetSize; ++i) {
+        if (isLetter(tables.alphabet.at(i))) {
+          mapChar(otherCase(tables.alphabet.at(i)), i);
+        }
+      }
+    }
+
+    // alphabets using a confusable letter decode it as itself only
+    const bool confusablesFree = alphabet.find_first_of("OoIiLl") == std::string_view::npos;
+    if ((leniency & gMapConfusables) != 0 && confusablesFree) {
+      constexpr std::array<std::array<char, 2>, 3> confusables{{{'O', '0'}, {'I', '1'}, {'L', '1'}}};
+      for (const auto& [confusable, digit]: confusables) {
+        const uint8_t value = tables.decode.at(static_cast<uint8_t>(digit));
+        if (value >= gB32AlphabetSize) {
+          continue;
+        }
+        mapChar(confusable, value);
+        if ((leniency & gIgnoreCase) != 0) {
+          mapChar(otherCase(confusable), value);
+        }
+      }
+      mapChar('-', gSkipChar);
+    }
+
+    mapChar(' ', gSkipChar);
+    if ((leniency & gSkipAllWhitespaces) != 0) {
+      for (const char chr: {'\t', '\n', '\v', '\f', '\r'}) {
+        mapChar(chr, gSkipChar);
+      }
+    }
+
+    return tables;
+  }
+
+  /*!
+   * \brief buildLenientTables
+   * \param alphabet 32 characters
+   * \return lookup tables for every combination of leniency flags
+   */
+  constexpr std::array<CodecTables, gLeniencyVariants> buildLenientTables(std::string_view alphabet) {
+    std::array<CodecTables, gLeniencyVariants> variants{};
+    for (uint8_t leniency = 0; leniency < gLeniencyVariants; ++leniency) {
+      variants.at(leniency) = buildCodecTables(alphabet, leniency);
+    }
+
+    return variants;
+  }
+
+  /*!
+   * \brief gRfc4648LenientTables
+   */
+  inline constexpr std::array<CodecTables, gLeniencyVariants> gRfc4648LenientTables =
+    buildLenientTables("ABCDEFGHIJKLMNOPQRSTUVWXYZ234567");
+
+  /*!
+   * \brief gRfc4648Tables
+   */
+  inline constexpr const CodecTables& gRfc4648Tables = gRfc4648LenientTables[gStrict];
+}  // namespace base32::detail
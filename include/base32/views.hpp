@@ -0,0 +1,277 @@
+#pragma once
+#include "base32/base32.hpp"
+#include "base32/stats.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace base32 {
+  /*!
+   * \brief gViewBlocks
+   *
+   * Views encode and decode this number of blocks at once with active kernels
+   */
+  constexpr size_t gViewBlocks = 64;
+
+  /*! \brief Range of 1 byte elements, e.g. bytes or characters
+   */
+  template <typename Range>
+  concept ByteInputRange = std::ranges::input_range<Range>
+                           && sizeof(std::ranges::range_value_t<Range>) == 1
+                           && std::is_trivially_copyable_v<std::ranges::range_value_t<Range>>;
+
+  /*! \brief Lazy base 32 encoding of a range of bytes
+   *
+   *  Single pass view producing characters. Input is consumed in chunks of gViewBlocks blocks which are
+   *  encoded by active kernels into a buffer of the view, so elements are read from the buffer and the
+   *  kernels do bulk work. Output is padded as encode pads it.
+   */
+  template <std::ranges::view View>
+    requires ByteInputRange<View>
+  class EncodeView: public std::ranges::view_interface<EncodeView<View>> {
+  public:
+    class Iterator {
+    public:
+      using iterator_concept = std::input_iterator_tag;
+      using value_type = char;
+      using difference_type = std::ptrdiff_t;
+
+      explicit Iterator(EncodeView* parent) : parent_(parent) {}
+
+      Iterator(Iterator&&) noexcept = default;
+      Iterator& operator=(Iterator&&) noexcept = default;
+
+      char operator*() const {
+        return parent_->chars_[parent_->position_];
+      }
+
+      Iterator& operator++() {
+        if (++parent_->position_ == parent_->filled_) {
+          parent_->fill();
+        }
+
+        return *this;
+      }
+
+      void operator++(int) {
+        ++*this;
+      }
+
+      friend bool operator==(const Iterator& iterator, std::default_sentinel_t /*sentinel*/) {
+        return iterator.finished();
+      }
+
+    private:
+      bool finished() const {
+        return parent_->position_ == parent_->filled_;
+      }
+
+      EncodeView* parent_;
+    };
+
+    explicit EncodeView(View base) : base_(std::move(base)) {}
+
+    /*! \brief Start encoding, may be called once
+     */
+    Iterator begin() {
+      current_ = std::ranges::begin(base_);
+      fill();
+
+      return Iterator(this);
+    }
+
+    std::default_sentinel_t end() const {
+      return std::default_sentinel;
+    }
+
+    /*! \brief Number of characters, known if input is sized
+     */
+    size_t size() const
+      requires std::ranges::sized_range<const View>
+    {
+      return encodedSize(static_cast<size_t>(std::ranges::size(base_)));
+    }
+
+  private:
+    void fill() {
+      std::array<uint8_t, gViewBlocks*5> bytes{};
+      size_t count = 0;
+      for (; count < bytes.size() && current_ != std::ranges::end(base_); ++current_) {
+        bytes[count++] = static_cast<uint8_t>(*current_);
+      }
+
+      // views are streams, their chunks are not counted as calls, as chunks of Encoder are not
+      const detail::UncountedScope uncounted;
+      Error errCode{};
+      position_ = 0;
+      filled_ = encodeInto(std::span<const uint8_t>(bytes.data(), count), chars_, errCode);
+    }
+
+    View base_;
+    std::ranges::iterator_t<View> current_{};
+    std::array<char, gViewBlocks*8> chars_{};
+    size_t position_{0};
+    size_t filled_{0};
+  };
+
+  /*! \brief Lazy base 32 decoding of a range of characters
+   *
+   *  Single pass view producing bytes. Input is consumed in chunks of gViewBlocks blocks which are
+   *  decoded by Decoder into a buffer of the view, so whitespaces and padding follow its rules.
+   *  Decoding stops at the first invalid character, bytes decoded before it are produced, error() tells
+   *  if the whole input was decoded.
+   */
+  template <std::ranges::view View>
+    requires ByteInputRange<View>
+  class DecodeView: public std::ranges::view_interface<DecodeView<View>> {
+  public:
+    class Iterator {
+    public:
+      using iterator_concept = std::input_iterator_tag;
+      using value_type = uint8_t;
+      using difference_type = std::ptrdiff_t;
+
+      explicit Iterator(DecodeView* parent) : parent_(parent) {}
+
+      Iterator(Iterator&&) noexcept = default;
+      Iterator& operator=(Iterator&&) noexcept = default;
+
+      uint8_t operator*() const {
+        return parent_->bytes_[parent_->position_];
+      }
+
+      Iterator& operator++() {
+        if (++parent_->position_ == parent_->filled_) {
+          parent_->fill();
+        }
+
+        return *this;
+      }
+
+      void operator++(int) {
+        ++*this;
+      }
+
+      friend bool operator==(const Iterator& iterator, std::default_sentinel_t /*sentinel*/) {
+        return iterator.finished();
+      }
+
+    private:
+      bool finished() const {
+        return parent_->position_ == parent_->filled_;
+      }
+
+      DecodeView* parent_;
+    };
+
+    explicit DecodeView(View base) : base_(std::move(base)) {}
+
+    /*! \brief Start decoding, may be called once
+     */
+    Iterator begin() {
+      current_ = std::ranges::begin(base_);
+      fill();
+
+      return Iterator(this);
+    }
+
+    std::default_sentinel_t end() const {
+      return std::default_sentinel;
+    }
+
+    /*! \brief Error decoding stopped on, NoError while input is valid
+     */
+    Error error() const {
+      return errCode_;
+    }
+
+  private:
+    void fill() {
+      position_ = 0;
+      filled_ = 0;
+      // a chunk of whitespaces or padding decodes to nothing, the next one is read then
+      while (filled_ == 0 && !finished_) {
+        std::array<char, gViewBlocks*8> chars{};
+        size_t count = 0;
+        for (; count < chars.size() && current_ != std::ranges::end(base_); ++current_) {
+          chars[count++] = static_cast<char>(*current_);
+        }
+
+        filled_ = decoder_.update(std::string_view(chars.data(), count), bytes_, errCode_);
+        if (errCode_ != Error::NoError) {
+          finished_ = true;
+        } else if (count < chars.size()) {
+          filled_ += decoder_.finalize(std::span(bytes_).subspan(filled_), errCode_);
+          finished_ = true;
+        }
+      }
+    }
+
+    View base_;
+    std::ranges::iterator_t<View> current_{};
+    Decoder decoder_;
+    std::array<uint8_t, gViewBlocks*5 + 4> bytes_{};
+    size_t position_{0};
+    size_t filled_{0};
+    Error errCode_{Error::NoError};
+    bool finished_{false};
+  };
+
+  template <typename Range>
+  EncodeView(Range&&) -> EncodeView<std::views::all_t<Range>>;
+
+  template <typename Range>
+  DecodeView(Range&&) -> DecodeView<std::views::all_t<Range>>;
+
+  /*! \brief range adaptors, e.g. bytes | base32::views::encode
+   */
+  namespace views {
+    /*!
+     * \brief The EncodeAdaptor struct
+     *
+     * Creates EncodeView, as a function or after |
+     */
+    struct EncodeAdaptor {
+      template <std::ranges::viewable_range Range>
+        requires ByteInputRange<Range>
+      auto operator()(Range&& range) const {
+        return EncodeView(std::forward<Range>(range));
+      }
+
+      template <std::ranges::viewable_range Range>
+        requires ByteInputRange<Range>
+      friend auto operator|(Range&& range, const EncodeAdaptor& adaptor) {
+        return adaptor(std::forward<Range>(range));
+      }
+    };
+
+    /*!
+     * \brief The DecodeAdaptor struct
+     *
+     * Creates DecodeView, as a function or after |
+     */
+    struct DecodeAdaptor {
+      template <std::ranges::viewable_range Range>
+        requires ByteInputRange<Range>
+      auto operator()(Range&& range) const {
+        return DecodeView(std::forward<Range>(range));
+      }
+
+      template <std::ranges::viewable_range Range>
+        requires ByteInputRange<Range>
+      friend auto operator|(Range&& range, const DecodeAdaptor& adaptor) {
+        return adaptor(std::forward<Range>(range));
+      }
+    };
+
+    inline constexpr EncodeAdaptor encode{};
+    inline constexpr DecodeAdaptor decode{};
+  }  // namespace views
+}  // namespace base32
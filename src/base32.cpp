@@ -1,101 +1,167 @@
 #include "base32/base32.hpp"
+#include "base32/codec.hpp"
+#include "base32/stats.hpp"
 
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
-#include <cstring>
-#include <array>
-#include <limits>
 #include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
-#include <utility>
 
 namespace {
-  constexpr uint8_t gBitsPerByte = 8;
-  constexpr uint8_t gBytesPerB32Block = 5;
-  constexpr uint8_t gBitsPerB32Block = gBitsPerByte*gBytesPerB32Block;
-
-  constexpr uint8_t gB32Padding6 = 6;
-  constexpr uint8_t gB32Padding4 = 4;
-  constexpr uint8_t gB32Padding3 = 3;
-  constexpr uint8_t gB32Padding1 = 1;
-
-  constexpr size_t gMaxEncodeInputLen = 64ULL * 1024 * 1024;
+  using base32::detail::gBytesPerB32Block;
+  using base32::detail::gCharsPerB32Block;
+  using base32::detail::getPayloadSize;
+  using base32::detail::wrappedSize;
+  using base32::detail::isPaddingValid;
+  using base32::detail::gRfc4648Tables;
+  using base32::detail::gSkipChar;
+  using base32::detail::gInvalidChar;
+  using base32::detail::validateEncodeInput;
 
   /*!
-   * \brief gMaxDecodeBasE32InputLen
+   * \brief encodeWrapped
    *
-   * if 64 MB of data is encoded than it should be also possible to decode it. That's why a bigger input is allowed for decoding
+   * Encode putting separator after every lineWidth characters. Blocks fitting in current line are encoded
+   * by kernels straight into output, only blocks crossing end of line go through a buffer.
+   * \param userData
+   * \param output buffer of wrappedSize characters
+   * \param options lineWidth is not zero
+   * \param tables
+   * \param padding
    */
-  constexpr size_t gMaxDecodeBase32InputLen = ((gMaxEncodeInputLen * gBitsPerByte + 4) / gBytesPerB32Block);
+  void encodeWrapped(std::span<const uint8_t> userData, char* output, const base32::EncodeOptions& options,
+                     const base32::detail::CodecTables& tables, base32::Padding padding) {
+    const base32::detail::Kernels& kernels = base32::detail::activeKernels();
+    const size_t lineWidth = options.lineWidth;
+    const std::string_view separator = options.lineSeparator;
+    size_t column = 0;
+    const auto startLine = [&]() {
+      if (column == lineWidth) {
+        std::ranges::copy(separator, output);
+        output += separator.size();
+        column = 0;
+      }
+    };
+    const auto put = [&](const char* chars, size_t count) {
+      while (count != 0) {
+        startLine();
+        const size_t piece = std::min(count, lineWidth - column);
+        std::copy_n(chars, piece, output);
+        output += piece;
+        chars += piece;
+        count -= piece;
+        column += piece;
+      }
+    };
+
+    const uint8_t* input = userData.data();
+    for (size_t blocks = userData.size() / gBytesPerB32Block; blocks != 0;) {
+      startLine();
+      const size_t lineBlocks = std::min(blocks, (lineWidth - column) / gCharsPerB32Block);
+      if (lineBlocks != 0) {
+        kernels.encode(input, lineBlocks, output, tables);
+        output += lineBlocks * gCharsPerB32Block;
+        column += lineBlocks * gCharsPerB32Block;
+      } else {
+        std::array<char, gCharsPerB32Block> block{};
+        base32::detail::encodeBlock(input, block.data(), tables);
+        put(block.data(), block.size());
+      }
+      const size_t encodedBlocks = std::max<size_t>(lineBlocks, 1);
+      input += encodedBlocks * gBytesPerB32Block;
+      blocks -= encodedBlocks;
+    }
 
-  constexpr std::array<uint8_t, 33> gB32Alphabet{"ABCDEFGHIJKLMNOPQRSTUVWXYZ234567"};
-  constexpr uint8_t gMaxAlphabetPosions = 128;
+    std::array<char, gCharsPerB32Block> tail{};
+    put(tail.data(), base32::detail::encodeTail(input, userData.size() % gBytesPerB32Block, tail.data(), tables, padding));
+  }
+}
 
-  /*!
-   * \brief buildPositionsInAlphabet
-   *
-   * positions in base 32 alphabet, O(1) cache
-   * \return
-   */
-  constexpr std::array<uint8_t, gMaxAlphabetPosions> buildPositionsInAlphabet() {
-    std::array<uint8_t, gMaxAlphabetPosions> table{};
-    table.fill(std::numeric_limits<uint8_t>::max());
 
-    for(size_t i = 0; i < std::size(gB32Alphabet); ++i) {
-      table.at(gB32Alphabet.at(i)) = static_cast<uint8_t>(i);
-    }
+namespace base32 {
+  size_t encodeInto(std::span<const uint8_t> userData, std::span<char> output, Error& errCode) {
+    return encodeInto(userData, output, errCode, EncodeOptions{});
+  }
 
-    return table;
+  size_t encodeInto(std::span<const uint8_t> userData, std::span<char> output, Error& errCode,
+                    const EncodeOptions& options) {
+    return detail::encodeInto(userData, output, errCode, options, gRfc4648Tables, options.padding);
   }
 
-  /*!
-   * \brief gPositionsInAlphabet
-   */
-  constexpr std::array<uint8_t, gMaxAlphabetPosions> gPositionsInAlphabet = buildPositionsInAlphabet();
+  size_t detail::encodeInto(std::span<const uint8_t> userData, std::span<char> output, Error& errCode,
+                            const EncodeOptions& options, const CodecTables& tables, Padding padding) {
+    StatsScope stats(Operation::Encode, userData.size(), errCode);
+    if (const Error error = validateEncodeInput(userData, options.maxInputLength); error != Error::NoError) {
+      errCode = error;
+      return 0;
+    }
 
-  /*!
-   * \brief buildAlphabetLookupTable
-   * \return alphabet lookup table
-   */
-  constexpr std::array<bool, gMaxAlphabetPosions> buildAlphabetLookupTable() {
-    std::array<bool, gMaxAlphabetPosions> table{};
-    for (const uint8_t pos: gB32Alphabet) {
-      table.at(pos) = true;
+    const size_t userDataChars = userData.size();
+    const size_t outputLength = wrappedSize(encodedSize(userDataChars, padding), options);
+    if (outputLength == gNoInputLimit) {
+      errCode = Error::MaxLengthExceeded;
+      return 0;
+    }
+    if (output.size() < outputLength) {
+      errCode = Error::BufferTooSmall;
+      return 0;
+    }
+
+    if (options.lineWidth != 0 && outputLength > options.lineWidth) {
+      encodeWrapped(userData, output.data(), options, tables, padding);
+      errCode = Error::NoError;
+      stats.setBytesOut(outputLength);
+      return outputLength;
     }
-    table['='] = true;
 
-    return table;
+    const size_t fullBlocks = userDataChars / gBytesPerB32Block;
+    if (options.threads != 1 && userDataChars >= options.parallelThreshold) {
+      encodeBlocksParallel(userData.data(), fullBlocks, output.data(), tables, options.threads);
+    } else {
+      activeKernels().encode(userData.data(), fullBlocks, output.data(), tables);
+    }
+
+    encodeTail(userData.data() + fullBlocks*gBytesPerB32Block, userDataChars % gBytesPerB32Block,
+               output.data() + fullBlocks*gCharsPerB32Block, tables, padding);
+
+    errCode = Error::NoError;
+    stats.setBytesOut(outputLength);
+
+    return outputLength;
   }
 
-  /*!
-   * \brief gAlphabetLookupTable
-   */
-  constexpr std::array<bool, gMaxAlphabetPosions> gAlphabetLookupTable = buildAlphabetLookupTable();
+  std::string encode(const Bytes& userData, Error &errCode) {
+    return encode(userData, errCode, EncodeOptions{});
+  }
 
-  /*!
-   * \brief inAlphabet
-   * \param val
-   * \return true if val in base 32 alphabet
-   */
-  constexpr bool inAlphabet(char val) {
-    if (val < 0) {
-      return false;
+  std::string encode(const Bytes& userData, Error &errCode, const EncodeOptions& options) {
+    detail::StatsScope stats(Operation::Encode, userData.size(), errCode);
+    if (const Error error = validateEncodeInput(userData, options.maxInputLength); error != Error::NoError) {
+      errCode = error;
+      return {};
     }
 
-    return gAlphabetLookupTable.at(val);
-  }
-}
+    std::string encodedData(encodedSize(userData.size(), options), '\0');
+    encodedData.resize(encodeInto(userData, encodedData, errCode, options));
+    stats.setBytesOut(encodedData.size());
 
+    return encodedData;
+  }
 
-namespace base32 {
   /*!
-   * \brief validateEncodeInput
+   * \brief validateDencodeInput
    * \param userData
    * \return
    */
-  Error validateEncodeInput(const Bytes& userData) {
-    if (userData.size() > gMaxEncodeInputLen) {
+  Error validateDecodeInput(const std::string_view& userData, size_t maxInputLength) {
+    if (userData.size() > maxInputLength) {
       return Error::MaxLengthExceeded;
     }
 
@@ -103,158 +169,357 @@ namespace base32 {
   }
 
   /*!
-   * \brief getPaddingBytesCount
+   * \brief decodePayload
    *
-   * Calculate base 32 padding to fill base 32 block (40 bits) if necessary
    * \param userData
-   * \return
+   * \param userDataChars - payload size
+   * \param decodedData output buffer, at least maxDecodedSize(userDataChars) bytes
+   * \param written number of bytes written to decodedData
+   * \param tables
+   * \param requirePadding reject input not padded as encode pads it
+   * \return error code
+   *
+   * \callgraph
+   * \callergraph
    */
-  uint8_t getPaddingBytesCount(const base32::Bytes& userData) {
-    const size_t userDataChars = userData.size();
-    const size_t totalBits = userDataChars*8;
-    uint8_t numOfEquals = 0;
-    switch (totalBits % gBitsPerB32Block) {
-      case 0:
-        break;
-      case gBitsPerByte:
-        numOfEquals = gB32Padding6;
-        break;
-      case uint8_t(2*gBitsPerByte):
-        numOfEquals = gB32Padding4;
-        break;
-      case uint8_t(3*gBitsPerByte):
-        numOfEquals = gB32Padding3;
-        break;
-      case uint8_t(4*gBitsPerByte):
-        numOfEquals = gB32Padding1;
-        break;
-      default:
-        std::unreachable();
+  Error decodePayload(const std::string_view& userData, size_t userDataChars, uint8_t* decodedData, size_t& written,
+                      const detail::CodecTables& tables, bool requirePadding) {
+    detail::DecodeState state;
+    const Error error = detail::decodeChars(state, reinterpret_cast<const uint8_t*>(userData.data()), userDataChars,
+                                            decodedData, written, tables);
+    if (error != Error::NoError) {
+      return error;
+    }
+    if (requirePadding && !isPaddingValid(userData.substr(userDataChars), state.count)) {
+      return Error::InvalidB32Input;
     }
 
-    return numOfEquals;
+    written += detail::finishDecode(state, decodedData + written);
+
+    return Error::NoError;
   }
 
-  std::string encode(const Bytes& userData, Error &errCode) {
-    if (const Error error = validateEncodeInput(userData); error != Error::NoError) {
+  size_t decodeInto(std::string_view userData, std::span<uint8_t> output, Error& errCode) {
+    return decodeInto(userData, output, errCode, DecodeOptions{});
+  }
+
+  size_t decodeInto(std::string_view userData, std::span<uint8_t> output, Error& errCode,
+                    const DecodeOptions& options) {
+    return detail::decodeInto(userData, output, errCode, options,
+                              detail::gRfc4648LenientTables[detail::leniencyOf(options)]);
+  }
+
+  size_t detail::decodeInto(std::string_view userData, std::span<uint8_t> output, Error& errCode,
+                            const DecodeOptions& options, const CodecTables& tables) {
+    StatsScope stats(Operation::Decode, userData.size(), errCode);
+    if (const Error error = validateDecodeInput(userData, options.maxInputLength); error != Error::NoError) {
       errCode = error;
-      return {};
+      return 0;
     }
 
-    const size_t userDataChars = userData.size();
-    const size_t outputLength = (userDataChars * 8 + 4) / gBytesPerB32Block;
-    const uint8_t numOfEquals = getPaddingBytesCount(userData);
-    std::string encodedData(outputLength + numOfEquals, '\0');
+    const size_t userDataChars = getPayloadSize(userData, tables);
+    if (output.size() < maxDecodedSize(userDataChars)) {
+      errCode = Error::BufferTooSmall;
+      return 0;
+    }
 
-    for (size_t i = 0, j = 0; i < userDataChars; i += gBytesPerB32Block) {
-      uint64_t quintuple = 0;
+    size_t written = 0;
+    size_t payloadChars = 0;
+    if (options.threads != 1 && userDataChars >= options.parallelThreshold
+        && decodeCharsParallel(reinterpret_cast<const uint8_t*>(userData.data()), userDataChars,
+                               output.data(), written, payloadChars, tables, options.threads)) {
+      const bool paddingValid = !options.requirePadding
+                                || isPaddingValid(userData.substr(userDataChars), payloadChars % gCharsPerB32Block);
+      errCode = paddingValid ? Error::NoError : Error::InvalidB32Input;
+      stats.setBytesOut(written);
+      return written;
+    }
 
-      for (size_t k = 0; k < gBytesPerB32Block; k++) {
-        quintuple = (quintuple << gBitsPerByte) | (i + k < userDataChars ? userData.at(i + k) : 0U);
-      }
+    errCode = decodePayload(userData, userDataChars, output.data(), written, tables, options.requirePadding);
+    stats.setBytesOut(written);
 
-      constexpr uint64_t mask = 0x1F;
+    return written;
+  }
 
-      for (int8_t shift = gBitsPerB32Block - gBytesPerB32Block; shift >= 0; shift -= gBytesPerB32Block) {
-        encodedData.at(j++) = static_cast<char>(gB32Alphabet.at((quintuple >> static_cast<uint8_t>(shift)) & mask));
-      }
+  std::span<uint8_t> decodeInPlace(std::span<char> buffer, Error& errCode, const DecodeOptions& options) {
+    return detail::decodeInPlace(buffer, errCode, options, detail::gRfc4648LenientTables[detail::leniencyOf(options)]);
+  }
+
+  std::span<uint8_t> detail::decodeInPlace(std::span<char> buffer, Error& errCode, const DecodeOptions& options,
+                                           const CodecTables& tables) {
+    // kernels load a chunk before storing its bytes and output never gets ahead of input, but threads
+    // would write over characters of preceding ranges
+    DecodeOptions inPlaceOptions = options;
+    inPlaceOptions.threads = 1;
+    const std::span<uint8_t> bytes(reinterpret_cast<uint8_t*>(buffer.data()), buffer.size());
+    const size_t written = decodeInto(std::string_view(buffer.data(), buffer.size()), bytes, errCode, inPlaceOptions, tables);
+
+    return bytes.first(written);
+  }
+
+  Bytes decode(std::string_view userData, Error &errCode) {
+    return decode(userData, errCode, DecodeOptions{});
+  }
+
+  Bytes decode(std::string_view userData, Error &errCode, const DecodeOptions& options) {
+    detail::StatsScope stats(Operation::Decode, userData.size(), errCode);
+    if (const Error error = validateDecodeInput(userData, options.maxInputLength); error != Error::NoError) {
+      errCode = error;
+      return {};
     }
 
-    for (uint8_t i = 0; i < numOfEquals; i++) {
-      encodedData[outputLength + i] = '=';
+    Bytes decodedData(maxDecodedSize(getPayloadSize(userData, detail::gRfc4648LenientTables[detail::leniencyOf(options)])));
+    decodedData.resize(decodeInto(userData, decodedData, errCode, options));
+    stats.setBytesOut(decodedData.size());
+
+    return decodedData;
+  }
+
+  DecodeError detail::decodeError(std::string_view userData, Error error, const DecodeOptions& options,
+                                  const CodecTables& tables) {
+    // decoding itself does no bookkeeping of offsets, error is located again by scanning
+    if (error == Error::MaxLengthExceeded) {
+      return {error, options.maxInputLength};
     }
 
-    errCode = Error::NoError;
+    size_t payloadChars = 0;
 
-    return encodedData;
+    return {error, scanChars(reinterpret_cast<const uint8_t*>(userData.data()), getPayloadSize(userData, tables),
+                             payloadChars, tables)};
   }
 
-  /*!
-   * \brief validateDencodeInput
-   * \param userData
-   * \return
-   */
-  Error validateDecodeInput(const std::string_view& userData) {
-    if (userData.size() > gMaxDecodeBase32InputLen) {
-      return Error::MaxLengthExceeded;
+  std::expected<Bytes, DecodeError> detail::decode(std::string_view userData, const DecodeOptions& options,
+                                                   const CodecTables& tables) {
+    Error errCode = validateDecodeInput(userData, options.maxInputLength);
+    StatsScope stats(Operation::Decode, userData.size(), errCode);
+    Bytes decodedData;
+    if (errCode == Error::NoError) {
+      decodedData.resize(maxDecodedSize(getPayloadSize(userData, tables)));
+      decodedData.resize(decodeInto(userData, decodedData, errCode, options, tables));
+      stats.setBytesOut(decodedData.size());
     }
 
-    return Error::NoError;
+    if (errCode != Error::NoError) [[unlikely]] {
+      return std::unexpected(decodeError(userData, errCode, options, tables));
+    }
+
+    return decodedData;
   }
 
-  /*!
-   * \brief getPayloadSize
-   *
-   * Base 32 string consist of 40 bits blocks padded with '='.
-   * This function calculates payload size to allocate buffer for decoded data.
-   *
-   * \param userData
-   * \return payload size
-   */
-  size_t getPayloadSize(const std::string_view& userData) {
-    size_t userDataChars = userData.size();
-    for (auto chr: userData | std::views::reverse) {
-      if (chr == '=') {
-        userDataChars -= 1;
-      } else {
-        break;
-      }
+  std::expected<Bytes, DecodeError> decode(std::string_view userData) {
+    return decode(userData, DecodeOptions{});
+  }
+
+  std::expected<Bytes, DecodeError> decode(std::string_view userData, const DecodeOptions& options) {
+    return detail::decode(userData, options, detail::gRfc4648LenientTables[detail::leniencyOf(options)]);
+  }
+
+  size_t detail::decodedSize(std::string_view userData, Error& errCode, const DecodeOptions& options,
+                             const CodecTables& tables) {
+    StatsScope stats(Operation::Validate, userData.size(), errCode);
+    if (const Error error = validateDecodeInput(userData, options.maxInputLength); error != Error::NoError) {
+      errCode = error;
+      return 0;
+    }
+
+    const size_t userDataChars = getPayloadSize(userData, tables);
+    size_t payloadChars = 0;
+    const size_t scanned = scanChars(reinterpret_cast<const uint8_t*>(userData.data()), userDataChars, payloadChars, tables);
+    errCode = scanned == userDataChars ? Error::NoError : Error::InvalidB32Input;
+    if (errCode == Error::NoError && options.requirePadding
+        && !isPaddingValid(userData.substr(userDataChars), payloadChars % gCharsPerB32Block)) {
+      errCode = Error::InvalidB32Input;
     }
 
-    return userDataChars;
+    return errCode == Error::NoError ? maxDecodedSize(payloadChars) : 0;
   }
 
-  /*!
-   * \brief decodePayload
-   * \param userData
-   * \param userDataChars - payload size
-   * \param decodedData Bytes out parameter
-   * \return error code
-   *
-   * \callgraph
-   * \callergraph
-   */
-  Error decodePayload(const std::string_view& userData, size_t userDataChars, Bytes& decodedData) {
-    uint8_t mask{0};
-    uint8_t currentByte{0};
-    uint8_t bitsLeft{gBitsPerByte};
-    for (size_t i = 0; i < userDataChars; i++) {
-      if (userData[i] == ' ') {
+  Error validate(std::string_view userData) {
+    return validate(userData, DecodeOptions{});
+  }
+
+  Error validate(std::string_view userData, const DecodeOptions& options) {
+    Error errCode{};
+    decodedSize(userData, errCode, options);
+
+    return errCode;
+  }
+
+  size_t decodedSize(std::string_view userData, Error& errCode) {
+    return decodedSize(userData, errCode, DecodeOptions{});
+  }
+
+  size_t decodedSize(std::string_view userData, Error& errCode, const DecodeOptions& options) {
+    return detail::decodedSize(userData, errCode, options,
+                               detail::gRfc4648LenientTables[detail::leniencyOf(options)]);
+  }
+
+  bool detail::decodedEquals(std::string_view userData, std::span<const uint8_t> expected,
+                             const DecodeOptions& options, const CodecTables& tables) {
+    // branches depend on userData only, bytes of expected are only combined into differences
+    Error errCode = validateDecodeInput(userData, options.maxInputLength);
+    StatsScope stats(Operation::Compare, userData.size(), errCode);
+    if (errCode != Error::NoError) {
+      return false;
+    }
+
+    uint8_t differences = 0;
+    bool tooLong = false;
+    size_t compared = 0;
+    const auto compare = [&](const uint8_t* decoded, size_t count) {
+      if (count > expected.size() - compared) {
+        tooLong = true;
+        return;
+      }
+      for (size_t k = 0; k < count; ++k) {
+        differences |= decoded[k] ^ expected[compared + k];
+      }
+      compared += count;
+    };
+
+    const size_t userDataChars = getPayloadSize(userData, tables);
+    const auto* input = reinterpret_cast<const uint8_t*>(userData.data());
+    std::array<uint8_t, gBytesPerB32Block> block{};
+    DecodeState state;
+    size_t i = 0;
+    while (i < userDataChars) {
+      if (state.count == 0 && userDataChars - i >= gCharsPerB32Block && decodeBlock(input + i, block.data(), tables)) {
+        compare(block.data(), gBytesPerB32Block);
+        i += gCharsPerB32Block;
         continue;
       }
-      else if (!inAlphabet(userData[i]))
-      {
-        return Error::InvalidB32Input;
+
+      const uint8_t value = tables.decode[input[i++]];
+      if (value == gSkipChar) {
+        continue;
       }
-      const uint8_t charIndex = gPositionsInAlphabet.at(userData[i]);
-      if (bitsLeft > gBytesPerB32Block) {
-        mask = charIndex << static_cast<uint8_t>(bitsLeft - gBytesPerB32Block);
-        currentByte |= mask;
-        bitsLeft -= gBytesPerB32Block;
-      } else {
-        mask = charIndex >> static_cast<uint8_t>(gBytesPerB32Block - bitsLeft);
-        currentByte |= mask;
-        decodedData.push_back(currentByte);
-        currentByte = (charIndex << static_cast<uint8_t>(gBitsPerByte - gBytesPerB32Block + bitsLeft));
-        bitsLeft += gBitsPerByte - gBytesPerB32Block;
+      if (value == gInvalidChar) {
+        errCode = Error::InvalidB32Input;
+        return false;
+      }
+
+      state.values[state.count++] = value;
+      if (state.count == gCharsPerB32Block) {
+        storeBlock(assembleBlock(state.values.data()), block.data());
+        compare(block.data(), gBytesPerB32Block);
+        state.count = 0;
       }
     }
 
-    return Error::NoError;
+    if (options.requirePadding && !isPaddingValid(userData.substr(userDataChars), state.count)) {
+      errCode = Error::InvalidB32Input;
+      return false;
+    }
+    const size_t tailBytes = finishDecode(state, block.data());
+    compare(block.data(), tailBytes);
+    std::ranges::fill(block, 0);
+
+    return (differences | static_cast<uint8_t>(tooLong) | static_cast<uint8_t>(compared != expected.size())) == 0;
   }
 
-  Bytes decode(std::string_view userData, Error &errCode) {
-    if (const Error error = validateDecodeInput(userData); error != Error::NoError) {
-      errCode = error;
-      return {};
+  bool decodedEquals(std::string_view userData, std::span<const uint8_t> expected) {
+    return decodedEquals(userData, expected, DecodeOptions{});
+  }
+
+  bool decodedEquals(std::string_view userData, std::span<const uint8_t> expected, const DecodeOptions& options) {
+    return detail::decodedEquals(userData, expected, options,
+                                 detail::gRfc4648LenientTables[detail::leniencyOf(options)]);
+  }
+
+  size_t encodeBatch(std::span<const std::span<const uint8_t>> inputs, std::span<char> output,
+                     std::span<size_t> lengths, Error& errCode) {
+    detail::StatsScope stats(Operation::EncodeBatch, 0, errCode);
+    if (lengths.size() < inputs.size()) {
+      errCode = Error::BufferTooSmall;
+      return 0;
     }
 
-    const size_t userDataChars = getPayloadSize(userData);
-    const size_t outputLength = userDataChars > 0? (5*userDataChars - 4)/8: 0;  // round up
-    Bytes decodedData;
-    decodedData.reserve(outputLength);
-    errCode =  decodePayload(userData, userDataChars, decodedData);
+    size_t outputLength = 0;
+    size_t inputLength = 0;
+    for (const auto& input: inputs) {
+      inputLength += input.size();
+      stats.setBytesIn(inputLength);
+      if (const Error error = validateEncodeInput(input, gDefaultMaxEncodeInputLen); error != Error::NoError) {
+        errCode = error;
+        return 0;
+      }
+      if (encodedSize(input.size()) > gNoInputLimit - outputLength) {
+        errCode = Error::MaxLengthExceeded;
+        return 0;
+      }
+      outputLength += encodedSize(input.size());
+    }
 
-    return decodedData;
+    if (output.size() < outputLength) {
+      errCode = Error::BufferTooSmall;
+      return 0;
+    }
+
+    const detail::EncodeKernel encode = detail::activeKernels().encode;
+    char* encoded = output.data();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      const auto& input = inputs[i];
+      const size_t fullBlocks = input.size() / gBytesPerB32Block;
+      encode(input.data(), fullBlocks, encoded, gRfc4648Tables);
+      const size_t tailChars = detail::encodeTail(input.data() + fullBlocks*gBytesPerB32Block,
+                                                  input.size() % gBytesPerB32Block,
+                                                  encoded + fullBlocks*gCharsPerB32Block, gRfc4648Tables,
+                                                  Padding::Enabled);
+      lengths[i] = fullBlocks*gCharsPerB32Block + tailChars;
+      encoded += lengths[i];
+    }
+
+    errCode = Error::NoError;
+    stats.setBytesOut(outputLength);
+
+    return outputLength;
+  }
+
+  size_t decodeBatch(std::span<const std::string_view> inputs, std::span<uint8_t> output,
+                     std::span<size_t> lengths, Error& errCode) {
+    detail::StatsScope stats(Operation::DecodeBatch, 0, errCode);
+    if (lengths.size() < inputs.size()) {
+      errCode = Error::BufferTooSmall;
+      return 0;
+    }
+
+    size_t outputLength = 0;
+    size_t inputLength = 0;
+    for (const auto& input: inputs) {
+      inputLength += input.size();
+      stats.setBytesIn(inputLength);
+      if (const Error error = validateDecodeInput(input, gDefaultMaxDecodeInputLen); error != Error::NoError) {
+        errCode = error;
+        return 0;
+      }
+      if (maxDecodedSize(input.size()) > gNoInputLimit - outputLength) {
+        errCode = Error::MaxLengthExceeded;
+        return 0;
+      }
+      outputLength += maxDecodedSize(input.size());
+    }
+
+    if (output.size() < outputLength) {
+      errCode = Error::BufferTooSmall;
+      return 0;
+    }
+
+    errCode = Error::NoError;
+    uint8_t* decoded = output.data();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      size_t written = 0;
+      errCode = decodePayload(inputs[i], getPayloadSize(inputs[i], gRfc4648Tables), decoded, written,
+                              gRfc4648Tables, false);
+      if (errCode != Error::NoError) {
+        std::fill(lengths.begin() + static_cast<std::ptrdiff_t>(i), lengths.begin() + static_cast<std::ptrdiff_t>(inputs.size()), 0);
+        break;
+      }
+
+      lengths[i] = written;
+      decoded += written;
+    }
+    stats.setBytesOut(static_cast<size_t>(decoded - output.data()));
+
+    return static_cast<size_t>(decoded - output.data());
   }
 }  // namespace base32
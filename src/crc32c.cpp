@@ -0,0 +1,126 @@
+#include "base32/checksum.hpp"
+
+#include "kernels.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#if defined(BASE32_ARCH_X86)
+#  include <immintrin.h>
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  endif
+#endif
+
+#if defined(BASE32_ARCH_ARM64) && defined(__ARM_FEATURE_CRC32)
+#  include <arm_acle.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define BASE32_TARGET(arch) __attribute__((target(arch)))
+#else
+#  define BASE32_TARGET(arch)
+#endif
+
+namespace {
+  /*!
+   * \brief gCrc32cPolynomial
+   *
+   * Castagnoli polynomial, bit reflected
+   */
+  constexpr uint32_t gCrc32cPolynomial = 0x82F63B78;
+
+  /*!
+   * \brief buildCrc32cTable
+   * \return register update for every byte
+   */
+  constexpr std::array<uint32_t, 256> buildCrc32cTable() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t byte = 0; byte < table.size(); ++byte) {
+      uint32_t crc = byte;
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = (crc & 1U) != 0 ? (crc >> 1U) ^ gCrc32cPolynomial : crc >> 1U;
+      }
+      table[byte] = crc;
+    }
+
+    return table;
+  }
+
+  constexpr std::array<uint32_t, 256> gCrc32cTable = buildCrc32cTable();
+
+  uint32_t crc32cScalar(uint32_t crc, const uint8_t* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+      crc = gCrc32cTable[(crc ^ data[i]) & 0xFFU] ^ (crc >> 8U);
+    }
+
+    return crc;
+  }
+
+#if defined(BASE32_ARCH_X86) && (defined(__x86_64__) || defined(_M_X64))
+  BASE32_TARGET("sse4.2")
+  uint32_t crc32cSse42(uint32_t crc, const uint8_t* data, size_t size) {
+    uint64_t crc64 = crc;
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), data += sizeof(uint64_t)) {
+      uint64_t word = 0;
+      std::memcpy(&word, data, sizeof(word));
+      crc64 = _mm_crc32_u64(crc64, word);
+    }
+    crc = static_cast<uint32_t>(crc64);
+    for (; size != 0; --size, ++data) {
+      crc = _mm_crc32_u8(crc, *data);
+    }
+
+    return crc;
+  }
+
+  /*!
+   * \brief cpuSupportsSse42
+   * \return true if crc32 instruction is available
+   */
+  bool cpuSupportsSse42() {
+#  if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4]{};
+    __cpuid(regs, 1);
+    constexpr int ecx = 2;
+    constexpr int sse42Bit = 20;
+    return (regs[ecx] & (1 << sse42Bit)) != 0;
+#  else
+    return __builtin_cpu_supports("sse4.2");
+#  endif
+  }
+#endif
+
+#if defined(BASE32_ARCH_ARM64) && defined(__ARM_FEATURE_CRC32)
+  uint32_t crc32cArm(uint32_t crc, const uint8_t* data, size_t size) {
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), data += sizeof(uint64_t)) {
+      uint64_t word = 0;
+      std::memcpy(&word, data, sizeof(word));
+      crc = __crc32cd(crc, word);
+    }
+    for (; size != 0; --size, ++data) {
+      crc = __crc32cb(crc, *data);
+    }
+
+    return crc;
+  }
+#endif
+}
+
+namespace base32::detail {
+  uint32_t crc32cUpdate(uint32_t crc, std::span<const uint8_t> data) {
+#if defined(BASE32_ARCH_X86) && (defined(__x86_64__) || defined(_M_X64))
+    static const bool hardware = cpuSupportsSse42();
+    if (hardware) {
+      return crc32cSse42(crc, data.data(), data.size());
+    }
+#elif defined(BASE32_ARCH_ARM64) && defined(__ARM_FEATURE_CRC32)
+    return crc32cArm(crc, data.data(), data.size());
+#endif
+
+    return crc32cScalar(crc, data.data(), data.size());
+  }
+}  // namespace base32::detail
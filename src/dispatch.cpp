@@ -0,0 +1,192 @@
+#include "kernels.hpp"
+
+#include <atomic>
+
+#if defined(BASE32_ARCH_X86) && defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+namespace {
+  using base32::Backend;
+  using base32::detail::Kernels;
+
+  constexpr Kernels gScalarKernels{Backend::Scalar, base32::detail::encodeBlocksScalar,
+                                   base32::detail::decodeBlocksScalar,
+                                   base32::detail::scanCharsScalar};
+
+#if defined(BASE32_ARCH_X86)
+  constexpr Kernels gSse41Kernels{Backend::Sse41, base32::detail::encodeBlocksSse41,
+                                  base32::detail::decodeBlocksSse41,
+                                  base32::detail::scanCharsSse41};
+  constexpr Kernels gAvx2Kernels{Backend::Avx2, base32::detail::encodeBlocksAvx2,
+                                 base32::detail::decodeBlocksAvx2,
+                                 base32::detail::scanCharsAvx2};
+  constexpr Kernels gAvx512Kernels{Backend::Avx512, base32::detail::encodeBlocksAvx512,
+                                   base32::detail::decodeBlocksAvx512,
+                                   base32::detail::scanCharsAvx512};
+#endif
+
+#if defined(BASE32_ARCH_ARM64)
+  constexpr Kernels gNeonKernels{Backend::Neon, base32::detail::encodeBlocksNeon,
+                                 base32::detail::decodeBlocksNeon,
+                                 base32::detail::scanCharsNeon};
+#endif
+
+  /*!
+   * \brief gActiveKernels
+   *
+   * nullptr until first use or explicit selectBackend call
+   */
+  std::atomic<const Kernels*> gActiveKernels{nullptr};
+
+#if defined(BASE32_ARCH_X86) && defined(_MSC_VER)
+  /*!
+   * \brief cpuidBit
+   * \return true if bit of cpuid register is set
+   */
+  bool cpuidBit(int leaf, int reg, int bit) {
+    int regs[4]{};
+    __cpuidex(regs, leaf, 0);
+    return (regs[reg] & (1 << bit)) != 0;
+  }
+
+  /*!
+   * \brief osSupportsAvx
+   * \return true if OS saves ymm registers on context switch
+   */
+  bool osSupportsAvx() {
+    constexpr int ecx = 2;
+    constexpr int osxsaveBit = 27;
+    constexpr unsigned long long ymmState = 0x6;
+    return cpuidBit(1, ecx, osxsaveBit) && (_xgetbv(0) & ymmState) == ymmState;
+  }
+
+  /*!
+   * \brief osSupportsAvx512
+   * \return true if OS saves zmm and opmask registers on context switch
+   */
+  bool osSupportsAvx512() {
+    constexpr unsigned long long zmmState = 0xE6;
+    return osSupportsAvx() && (_xgetbv(0) & zmmState) == zmmState;
+  }
+#endif
+
+  /*!
+   * \brief kernelsOf
+   * \param backend
+   * \return kernels of backend, nullptr if backend is not compiled in
+   */
+  const Kernels* kernelsOf(Backend backend) {
+    switch (backend) {
+      case Backend::Scalar:
+        return &gScalarKernels;
+#if defined(BASE32_ARCH_X86)
+      case Backend::Sse41:
+        return &gSse41Kernels;
+      case Backend::Avx2:
+        return &gAvx2Kernels;
+      case Backend::Avx512:
+        return &gAvx512Kernels;
+#endif
+#if defined(BASE32_ARCH_ARM64)
+      case Backend::Neon:
+        return &gNeonKernels;
+#endif
+      default:
+        return nullptr;
+    }
+  }
+
+  /*!
+   * \brief bestKernels
+   * \return kernels of the fastest backend supported by current CPU
+   */
+  const Kernels* bestKernels() {
+    for (const Backend backend: {Backend::Avx512, Backend::Avx2, Backend::Sse41, Backend::Neon}) {
+      if (base32::detail::cpuSupports(backend)) {
+        return kernelsOf(backend);
+      }
+    }
+
+    return &gScalarKernels;
+  }
+}
+
+namespace base32::detail {
+  bool cpuSupports(Backend backend) {
+    switch (backend) {
+      case Backend::Scalar:
+        return true;
+#if defined(BASE32_ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+      case Backend::Sse41:
+        return __builtin_cpu_supports("sse4.1");
+      case Backend::Avx2:
+        return __builtin_cpu_supports("avx2");
+      case Backend::Avx512:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")
+               && __builtin_cpu_supports("avx512vbmi");
+#elif defined(BASE32_ARCH_X86) && defined(_MSC_VER)
+      case Backend::Sse41: {
+        constexpr int ecx = 2;
+        constexpr int sse41Bit = 19;
+        return cpuidBit(1, ecx, sse41Bit);
+      }
+      case Backend::Avx2: {
+        constexpr int ebx = 1;
+        constexpr int avx2Bit = 5;
+        return osSupportsAvx() && cpuidBit(7, ebx, avx2Bit);
+      }
+      case Backend::Avx512: {
+        constexpr int ebx = 1;
+        constexpr int ecx = 2;
+        constexpr int avx512fBit = 16;
+        constexpr int avx512bwBit = 30;
+        constexpr int avx512vbmiBit = 1;
+        return osSupportsAvx512() && cpuidBit(7, ebx, avx512fBit) && cpuidBit(7, ebx, avx512bwBit)
+               && cpuidBit(7, ecx, avx512vbmiBit);
+      }
+#endif
+#if defined(BASE32_ARCH_ARM64)
+      // Advanced SIMD is a mandatory part of AArch64
+      case Backend::Neon:
+        return true;
+#endif
+      default:
+        return false;
+    }
+  }
+
+  const Kernels& activeKernels() {
+    const Kernels* kernels = gActiveKernels.load(std::memory_order_acquire);
+    if (kernels == nullptr) {
+      kernels = bestKernels();
+      gActiveKernels.store(kernels, std::memory_order_release);
+    }
+
+    return *kernels;
+  }
+}  // namespace base32::detail
+
+namespace base32 {
+  Backend activeBackend() {
+    return detail::activeKernels().backend;
+  }
+
+  bool isBackendSupported(Backend backend) {
+    return kernelsOf(backend) != nullptr && detail::cpuSupports(backend);
+  }
+
+  bool selectBackend(Backend backend) {
+    if (!isBackendSupported(backend)) {
+      return false;
+    }
+
+    gActiveKernels.store(kernelsOf(backend), std::memory_order_release);
+
+    return true;
+  }
+
+  void resetBackend() {
+    gActiveKernels.store(bestKernels(), std::memory_order_release);
+  }
+}  // namespace base32
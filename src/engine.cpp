@@ -0,0 +1,150 @@
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <string_view>
+
+namespace {
+  /*!
+   * \brief gKernelRetryChars
+   *
+   * After a kernel stopped at a whitespace or an invalid char within gKernelMinRunChars characters,
+   * the next blocks are decoded by scalar code for this distance. Input with frequent whitespaces would otherwise pay for loading
+   * kernel tables at every block.
+   */
+  constexpr size_t gKernelRetryChars = 256;
+
+  /*!
+   * \brief gKernelMinRunChars
+   *
+   * Kernel runs at least this long are worth restarting right away, e.g. lines of wrapped input
+   */
+  constexpr size_t gKernelMinRunChars = 32;
+}
+
+namespace base32::detail {
+  size_t encodeTail(const uint8_t* input, size_t tailBytes, char* output, const CodecTables& tables,
+                    Padding padding) {
+    if (tailBytes == 0) {
+      return 0;
+    }
+
+    std::array<uint8_t, gBytesPerB32Block> lastBlock{};
+    std::memcpy(lastBlock.data(), input, tailBytes);
+    std::array<char, gCharsPerB32Block> lastChars{};
+    encodeBlock(lastBlock.data(), lastChars.data(), tables);
+
+    const size_t tailChars = (tailBytes*gBitsPerByte + gBitsPerB32Char - 1) / gBitsPerB32Char;
+    std::memcpy(output, lastChars.data(), tailChars);
+    if (padding == Padding::Disabled) {
+      return tailChars;
+    }
+    std::memset(output + tailChars, '=', gCharsPerB32Block - tailChars);
+
+    return gCharsPerB32Block;
+  }
+
+  size_t getPayloadSize(std::string_view userData, const CodecTables& tables) {
+    size_t userDataChars = userData.size();
+    for (auto chr: userData | std::views::reverse) {
+      if (chr == '=' || tables.decode[static_cast<uint8_t>(chr)] == gSkipChar) {
+        userDataChars -= 1;
+      } else {
+        break;
+      }
+    }
+
+    return userDataChars;
+  }
+
+  bool isPaddingValid(std::string_view padding, size_t tailChars) {
+    const auto paddingChars = static_cast<size_t>(std::ranges::count(padding, '='));
+    if (tailChars == 0) {
+      return paddingChars == 0;
+    }
+
+    const size_t tailBytes = tailDecodedSize(tailChars);
+
+    return tailChars == (tailBytes*gBitsPerByte + gBitsPerB32Char - 1) / gBitsPerB32Char
+           && paddingChars == gCharsPerB32Block - tailChars;
+  }
+
+  Error decodeChars(DecodeState& state, const uint8_t* input, size_t inputLen, uint8_t* output,
+                    size_t& written, const CodecTables& tables) {
+    uint8_t* const outputBegin = output;
+    const Kernels& kernels = activeKernels();
+
+    size_t i = 0;
+    size_t kernelRetryAt = 0;
+    while (i < inputLen) {
+      if (state.count == 0) {
+        // line separators between blocks are skipped here, so kernels start at the next line
+        while (i < inputLen && tables.decode[input[i]] == gSkipChar) {
+          ++i;
+        }
+        if (i == inputLen) {
+          break;
+        }
+
+        const bool useKernel = i >= kernelRetryAt;
+        const size_t consumed = useKernel ? kernels.decode(input + i, inputLen - i, output, tables)
+                                          : decodeBlocksScalar(input + i, inputLen - i, output, tables);
+        if (useKernel && consumed < gKernelMinRunChars && consumed < inputLen - i) {
+          kernelRetryAt = i + gKernelRetryChars;
+        }
+        i += consumed;
+        output += consumed / gCharsPerB32Block * gBytesPerB32Block;
+        if (i == inputLen) {
+          break;
+        }
+      }
+
+      const uint8_t value = tables.decode[input[i++]];
+      if (value == gSkipChar) {
+        continue;
+      }
+      if (value == gInvalidChar) [[unlikely]] {
+        written = static_cast<size_t>(output - outputBegin);
+        return Error::InvalidB32Input;
+      }
+
+      state.values[state.count++] = value;
+      if (state.count == gCharsPerB32Block) {
+        storeBlock(assembleBlock(state.values.data()), output);
+        output += gBytesPerB32Block;
+        state.count = 0;
+      }
+    }
+
+    written = static_cast<size_t>(output - outputBegin);
+
+    return Error::NoError;
+  }
+
+  size_t scanChars(const uint8_t* input, size_t inputLen, size_t& payloadChars, const CodecTables& tables) {
+    payloadChars = 0;
+    const size_t scanned = activeKernels().scan(input, inputLen, tables, payloadChars);
+
+    return scanned + scanCharsScalar(input + scanned, inputLen - scanned, tables, payloadChars);
+  }
+
+  size_t finishDecode(DecodeState& state, uint8_t* output) {
+    if (state.count == 0) {
+      return 0;
+    }
+
+    std::fill(state.values.begin() + state.count, state.values.end(), 0);
+    std::array<uint8_t, gBytesPerB32Block> lastBlock{};
+    storeBlock(assembleBlock(state.values.data()), lastBlock.data());
+
+    const size_t tailBytes = tailDecodedSize(state.count);
+    std::memcpy(output, lastBlock.data(), tailBytes);
+    state.count = 0;
+
+    return tailBytes;
+  }
+}  // namespace base32::detail
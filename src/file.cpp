@@ -0,0 +1,386 @@
+#include "base32/file.hpp"
+#include "base32/stats.hpp"
+
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <numeric>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#  define BASE32_HAS_MMAP 1
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#else
+#  include <fstream>
+#  include <vector>
+#endif
+
+namespace {
+  using base32::detail::gBytesPerB32Block;
+  using base32::detail::gCharsPerB32Block;
+
+  /*!
+   * \brief gFileChunkBlocks
+   *
+   * Files are processed in chunks of this number of blocks, so the output of one chunk stays in cache
+   */
+  constexpr size_t gFileChunkBlocks = 4ULL * 1024 * 1024;
+  constexpr size_t gEncodeChunkBytes = gFileChunkBlocks*gBytesPerB32Block;
+  constexpr size_t gDecodeChunkChars = gFileChunkBlocks*gCharsPerB32Block;
+
+  /*!
+   * \brief encodeChunkBytes
+   *
+   * Chunks of wrapped output end at end of line, so every chunk is wrapped on its own
+   * \param options
+   * \param fileSize
+   * \return number of bytes encoded at once
+   */
+  size_t encodeChunkBytes(const base32::EncodeOptions& options, size_t fileSize) {
+    if (options.lineWidth == 0) {
+      return gEncodeChunkBytes;
+    }
+    if (options.lineWidth > gDecodeChunkChars) {
+      return fileSize;
+    }
+
+    const size_t lineBlocks = std::lcm(options.lineWidth, gCharsPerB32Block) / gCharsPerB32Block;
+
+    return std::max<size_t>(gFileChunkBlocks / lineBlocks, 1) * lineBlocks * gBytesPerB32Block;
+  }
+
+  /*!
+   * \brief isSameFile
+   *
+   * Output is truncated before input is read, so it must not be the input under any name
+   * \param input
+   * \param output
+   * \return true if output exists and is the input file
+   */
+  bool isSameFile(const std::filesystem::path& input, const std::filesystem::path& output) {
+    std::error_code error;
+    return std::filesystem::equivalent(input, output, error);
+  }
+
+  /*!
+   * \brief The InputFile class
+   *
+   * Read only view of whole file, memory mapped where possible
+   */
+  class InputFile {
+  public:
+    InputFile() = default;
+    InputFile(const InputFile&) = delete;
+    InputFile& operator=(const InputFile&) = delete;
+
+    ~InputFile() {
+#if defined(BASE32_HAS_MMAP)
+      if (data_ != nullptr) {
+        munmap(data_, size_);
+      }
+#endif
+    }
+
+    /*!
+     * \brief open
+     * \param path
+     * \return false if file can't be read
+     */
+    bool open(const std::filesystem::path& path) {
+#if defined(BASE32_HAS_MMAP)
+      const int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0) {
+        return false;
+      }
+
+      struct stat status{};
+      bool opened = fstat(fd, &status) == 0;
+      size_ = opened ? static_cast<size_t>(status.st_size) : 0;
+      if (opened && size_ > 0) {
+        data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        opened = data_ != MAP_FAILED;
+        if (opened) {
+          madvise(data_, size_, MADV_SEQUENTIAL);
+        } else {
+          data_ = nullptr;
+        }
+      }
+      close(fd);
+
+      return opened;
+#else
+      std::ifstream file(path, std::ios::binary | std::ios::ate);
+      if (!file) {
+        return false;
+      }
+      buffer_.resize(static_cast<size_t>(file.tellg()));
+      file.seekg(0);
+
+      return static_cast<bool>(file.read(reinterpret_cast<char*>(buffer_.data()),
+                                         static_cast<std::streamsize>(buffer_.size())));
+#endif
+    }
+
+    [[nodiscard]] std::span<const uint8_t> bytes() const {
+#if defined(BASE32_HAS_MMAP)
+      return {static_cast<const uint8_t*>(data_), data_ != nullptr ? size_ : 0};
+#else
+      return buffer_;
+#endif
+    }
+
+  private:
+#if defined(BASE32_HAS_MMAP)
+    void* data_ = nullptr;
+    size_t size_ = 0;
+#else
+    std::vector<uint8_t> buffer_;
+#endif
+  };
+
+  /*!
+   * \brief The OutputFile class
+   *
+   * Writable view of a file of size known up front, memory mapped where possible
+   */
+  class OutputFile {
+  public:
+    OutputFile() = default;
+    OutputFile(const OutputFile&) = delete;
+    OutputFile& operator=(const OutputFile&) = delete;
+
+    ~OutputFile() {
+      close();
+    }
+
+    /*!
+     * \brief open
+     *
+     * Create or truncate file and resize it
+     * \param path
+     * \param size
+     * \return false if file can't be created
+     */
+    bool open(const std::filesystem::path& path, size_t size) {
+      size_ = size;
+#if defined(BASE32_HAS_MMAP)
+      fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+      if (fd_ < 0 || ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+        return false;
+      }
+      if (size == 0) {
+        return true;
+      }
+
+      data_ = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+      if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        return false;
+      }
+
+      return true;
+#else
+      path_ = path;
+      buffer_.resize(size);
+
+      return true;
+#endif
+    }
+
+    [[nodiscard]] std::span<uint8_t> bytes() {
+#if defined(BASE32_HAS_MMAP)
+      return {static_cast<uint8_t*>(data_), data_ != nullptr ? size_ : 0};
+#else
+      return buffer_;
+#endif
+    }
+
+    /*!
+     * \brief close
+     * \return false if data can't be written
+     */
+    bool close() {
+      bool written = true;
+#if defined(BASE32_HAS_MMAP)
+      if (data_ != nullptr) {
+        written = munmap(data_, size_) == 0;
+        data_ = nullptr;
+      }
+      if (fd_ >= 0) {
+        written = ::close(fd_) == 0 && written;
+        fd_ = -1;
+      }
+#else
+      if (!path_.empty()) {
+        std::ofstream file(path_, std::ios::binary | std::ios::trunc);
+        written = static_cast<bool>(file.write(reinterpret_cast<const char*>(buffer_.data()),
+                                               static_cast<std::streamsize>(buffer_.size())));
+        path_.clear();
+      }
+#endif
+
+      return written;
+    }
+
+  private:
+    size_t size_ = 0;
+#if defined(BASE32_HAS_MMAP)
+    int fd_ = -1;
+    void* data_ = nullptr;
+#else
+    std::filesystem::path path_;
+    std::vector<uint8_t> buffer_;
+#endif
+  };
+}
+
+namespace base32 {
+  namespace {
+    /*!
+     * \brief encodeMapped
+     *
+     * encodeFile counted by stats as one call
+     */
+    Error encodeMapped(const std::filesystem::path& input, const std::filesystem::path& output,
+                       const EncodeOptions& options, detail::StatsScope& stats) {
+      InputFile inputFile;
+      if (!inputFile.open(input)) {
+        return Error::IoError;
+      }
+
+      const std::span<const uint8_t> bytes = inputFile.bytes();
+      stats.setBytesIn(bytes.size());
+      if (const Error error = detail::validateEncodeInput(bytes, gNoInputLimit); error != Error::NoError) {
+        return error;
+      }
+      // wrapped length saturates when line separators don't fit size_t
+      const size_t outputSize = encodedSize(bytes.size(), options);
+      if (outputSize == gNoInputLimit) {
+        return Error::MaxLengthExceeded;
+      }
+      if (isSameFile(input, output)) {
+        return Error::IoError;
+      }
+      OutputFile outputFile;
+      if (!outputFile.open(output, outputSize)) {
+        return Error::IoError;
+      }
+
+      // chunks are whole blocks, so only the last one has a tail and padding, and whole lines of wrapped output,
+      // so chunks are followed by separator except the last one
+      EncodeOptions chunkOptions = options;
+      chunkOptions.maxInputLength = gNoInputLimit;
+      const size_t chunkBytes = encodeChunkBytes(options, bytes.size());
+      const std::string_view separator = options.lineWidth != 0 ? options.lineSeparator : std::string_view();
+      const size_t chunkStride = detail::wrappedSize(chunkBytes / gBytesPerB32Block * gCharsPerB32Block, options)
+                                 + separator.size();
+      const auto encoded = outputFile.bytes();
+      for (size_t offset = 0; offset < bytes.size(); offset += chunkBytes) {
+        const auto chunk = bytes.subspan(offset, std::min(chunkBytes, bytes.size() - offset));
+        const auto chunkOutput = encoded.subspan(offset / chunkBytes * chunkStride);
+        Error errCode{};
+        const size_t written = encodeInto(chunk, std::span(reinterpret_cast<char*>(chunkOutput.data()),
+                                                           chunkOutput.size()),
+                                          errCode, chunkOptions);
+        if (errCode != Error::NoError) {
+          return errCode;
+        }
+        if (offset + chunk.size() < bytes.size()) {
+          std::ranges::copy(separator, chunkOutput.data() + written);
+        }
+      }
+      stats.setBytesOut(encoded.size());
+
+      return outputFile.close() ? Error::NoError : Error::IoError;
+    }
+
+    /*!
+     * \brief decodeMapped
+     *
+     * decodeFile counted by stats as one call
+     */
+    Error decodeMapped(const std::filesystem::path& input, const std::filesystem::path& output,
+                       const DecodeOptions& options, detail::StatsScope& stats) {
+      InputFile inputFile;
+      if (!inputFile.open(input)) {
+        return Error::IoError;
+      }
+
+      const std::span<const uint8_t> chars = inputFile.bytes();
+      stats.setBytesIn(chars.size());
+      const std::string_view text(reinterpret_cast<const char*>(chars.data()), chars.size());
+      const auto& tables = detail::gRfc4648LenientTables[detail::leniencyOf(options)];
+      const size_t userDataChars = detail::getPayloadSize(text, tables);
+
+      // whole input is validated before output is created, maxInputLength is not applied
+      size_t payloadChars = 0;
+      if (detail::scanChars(chars.data(), userDataChars, payloadChars, tables) != userDataChars
+          || (options.requirePadding
+              && !detail::isPaddingValid(text.substr(userDataChars), payloadChars % gCharsPerB32Block))) {
+        return Error::InvalidB32Input;
+      }
+      const size_t outputSize = maxDecodedSize(payloadChars);
+
+      if (isSameFile(input, output)) {
+        return Error::IoError;
+      }
+      OutputFile outputFile;
+      if (!outputFile.open(output, outputSize)) {
+        return Error::IoError;
+      }
+
+      // parallel decoding starts at a block boundary and finishes the last block, so a chunk is decoded in parallel
+      // if preceding chunks ended on a block boundary, and it is the last one or nothing is skipped
+      const bool contiguous = payloadChars == userDataChars;
+      Error errCode{};
+      detail::DecodeState state;
+      uint8_t* decoded = outputFile.bytes().data();
+      for (size_t offset = 0; offset < userDataChars; offset += gDecodeChunkChars) {
+        const size_t chunkChars = std::min(gDecodeChunkChars, userDataChars - offset);
+        size_t written = 0;
+        size_t chunkPayloadChars = 0;
+        const bool parallel = state.count == 0 && (contiguous || offset + chunkChars == userDataChars)
+                              && options.threads != 1 && chunkChars >= options.parallelThreshold
+                              && detail::decodeCharsParallel(chars.data() + offset, chunkChars, decoded, written,
+                                                             chunkPayloadChars, tables, options.threads);
+        if (!parallel) {
+          errCode = detail::decodeChars(state, chars.data() + offset, chunkChars, decoded, written, tables);
+        }
+        if (errCode != Error::NoError) {
+          return errCode;
+        }
+        decoded += written;
+      }
+      detail::finishDecode(state, decoded);
+      stats.setBytesOut(outputSize);
+
+      return outputFile.close() ? Error::NoError : Error::IoError;
+    }
+  }  // namespace
+
+  Error encodeFile(const std::filesystem::path& input, const std::filesystem::path& output,
+                   const EncodeOptions& options) {
+    Error errCode = Error::NoError;
+    detail::StatsScope stats(Operation::Encode, 0, errCode);
+    errCode = encodeMapped(input, output, options, stats);
+
+    return errCode;
+  }
+
+  Error decodeFile(const std::filesystem::path& input, const std::filesystem::path& output,
+                   const DecodeOptions& options) {
+    Error errCode = Error::NoError;
+    detail::StatsScope stats(Operation::Decode, 0, errCode);
+    errCode = decodeMapped(input, output, options, stats);
+
+    return errCode;
+  }
+}  // namespace base32
@@ -0,0 +1,237 @@
+#pragma once
+#include "base32/base32.hpp"
+#include "base32/tables.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#  define BASE32_ARCH_X86 1
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#  define BASE32_ARCH_ARM64 1
+#endif
+
+/*! \brief internal engine shared by all backends
+ *
+ *  Kernels process whole base 32 blocks only, padding, tails and validation of arguments
+ *  are handled by the callers in base32.cpp
+ */
+namespace base32::detail {
+  /*!
+   * \brief EncodeKernel
+   *
+   * Encode blocksCount whole 5 bytes blocks as 8 characters each
+   */
+  using EncodeKernel = void (*)(const uint8_t* input, size_t blocksCount, char* output,
+                                const CodecTables& tables);
+
+  /*!
+   * \brief DecodeKernel
+   *
+   * Decode whole 8 characters blocks until the end of input or the first block with a character
+   * out of alphabet, such a block is left to the caller. Output has room for maxDecodedSize(inputLen) bytes.
+   * Returns number of characters consumed, multiple of 8.
+   */
+  using DecodeKernel = size_t (*)(const uint8_t* input, size_t inputLen, uint8_t* output,
+                                  const CodecTables& tables);
+
+  /*!
+   * \brief ScanKernel
+   *
+   * Check characters without decoding them until the end of input or a chunk with a character
+   * out of alphabet which is not skipped, such a chunk is left to the caller.
+   * Adds number of alphabet characters to payloadChars, returns number of characters consumed.
+   */
+  using ScanKernel = size_t (*)(const uint8_t* input, size_t inputLen, const CodecTables& tables,
+                                size_t& payloadChars);
+
+  /*!
+   * \brief Kernels
+   *
+   * set of functions implementing one backend
+   */
+  struct Kernels {
+    Backend backend;
+    EncodeKernel encode;
+    DecodeKernel decode;
+    ScanKernel scan;
+  };
+
+  /*!
+   * \brief activeKernels
+   *
+   * Best supported backend is selected on first use unless selectBackend was called before
+   * \return kernels of active backend
+   */
+  const Kernels& activeKernels();
+
+  /*!
+   * \brief cpuSupports
+   * \param backend
+   * \return true if current CPU can run backend
+   */
+  bool cpuSupports(Backend backend);
+
+  /*!
+   * \brief DecodeState
+   *
+   * positions of characters of a block which is not complete yet
+   */
+  struct DecodeState {
+    std::array<uint8_t, gCharsPerB32Block> values{};
+    uint8_t count{0};
+  };
+
+  /*!
+   * \brief tailDecodedSize
+   * \param charsCount number of characters of incomplete block
+   * \return number of whole bytes they carry
+   */
+  constexpr size_t tailDecodedSize(size_t charsCount) {
+    return charsCount*gBitsPerB32Char / gBitsPerByte;
+  }
+
+  /*!
+   * \brief encodeTail
+   *
+   * Encode last incomplete block, padded with '=' unless padding is disabled
+   * \param input
+   * \param tailBytes less than 5
+   * \param output 8 characters if tailBytes is not zero
+   * \param tables
+   * \param padding
+   * \return number of characters written
+   */
+  size_t encodeTail(const uint8_t* input, size_t tailBytes, char* output, const CodecTables& tables,
+                    Padding padding);
+
+  /*!
+   * \brief getPayloadSize
+   *
+   * Base 32 string consist of 40 bits blocks padded with '='. Whitespaces around padding are not a part of payload.
+   * This function calculates payload size to allocate buffer for decoded data.
+   *
+   * \param userData
+   * \param tables
+   * \return payload size
+   */
+  size_t getPayloadSize(std::string_view userData, const CodecTables& tables);
+
+  /*!
+   * \brief isPaddingValid
+   *
+   * Canonical padding completes the last block to 8 characters, and a block can't end after 1, 3 or 6 characters
+   * \param padding trailing characters excluded from payload
+   * \param tailChars number of characters of the last incomplete block
+   * \return true if input is padded as encode pads it
+   */
+  bool isPaddingValid(std::string_view padding, size_t tailChars);
+
+  /*!
+   * \brief decodeChars
+   *
+   * Decode characters continuing the block kept in state. Whole 8 characters blocks are decoded by
+   * active kernels, char by char decoding is used only for blocks interrupted by whitespaces
+   * and for incomplete blocks, which are left in state.
+   *
+   * \param state
+   * \param input
+   * \param inputLen
+   * \param output buffer, at least (state.count + inputLen) / 8 * 5 bytes
+   * \param written number of bytes written to output
+   * \param tables
+   * \return error code
+   *
+   * \callgraph
+   * \callergraph
+   */
+  Error decodeChars(DecodeState& state, const uint8_t* input, size_t inputLen, uint8_t* output,
+                    size_t& written, const CodecTables& tables);
+
+  /*!
+   * \brief scanChars
+   *
+   * Validate characters with active kernels without decoding them
+   * \param input
+   * \param inputLen
+   * \param payloadChars number of alphabet characters, whitespaces are not counted
+   * \param tables
+   * \return offset of the first character neither in alphabet nor skipped, inputLen if there is no such one
+   */
+  size_t scanChars(const uint8_t* input, size_t inputLen, size_t& payloadChars, const CodecTables& tables);
+
+  /*!
+   * \brief finishDecode
+   *
+   * Decode incomplete block kept in state, bits not forming a whole byte are dropped
+   * \param state
+   * \param output at least tailDecodedSize(state.count) bytes
+   * \return number of bytes written
+   */
+  size_t finishDecode(DecodeState& state, uint8_t* output);
+
+  /*!
+   * \brief encodeBlocksParallel
+   *
+   * Encode whole blocks splitting them between threads
+   * \param threads 0 for hardware concurrency
+   */
+  void encodeBlocksParallel(const uint8_t* input, size_t blocksCount, char* output,
+                            const CodecTables& tables, unsigned threads);
+
+  /*!
+   * \brief decodeCharsParallel
+   *
+   * Decode payload splitting it between threads at 8 payload characters boundaries, including the last incomplete
+   * block. Slices are scanned in parallel first, so skipped characters move boundaries and invalid input is rejected
+   * before decoding.
+   * \param payloadChars number of alphabet characters
+   * \param threads 0 for hardware concurrency
+   * \return false if input is too small to split or has errors, nothing is written then
+   *          and input should be decoded sequentially.
+   */
+  bool decodeCharsParallel(const uint8_t* input, size_t inputLen, uint8_t* output, size_t& written,
+                           size_t& payloadChars, const CodecTables& tables, unsigned threads);
+
+  void encodeBlocksScalar(const uint8_t* input, size_t blocksCount, char* output,
+                          const CodecTables& tables);
+  size_t decodeBlocksScalar(const uint8_t* input, size_t inputLen, uint8_t* output,
+                            const CodecTables& tables);
+  size_t scanCharsScalar(const uint8_t* input, size_t inputLen, const CodecTables& tables,
+                         size_t& payloadChars);
+
+#if defined(BASE32_ARCH_X86)
+  void encodeBlocksSse41(const uint8_t* input, size_t blocksCount, char* output,
+                         const CodecTables& tables);
+  void encodeBlocksAvx2(const uint8_t* input, size_t blocksCount, char* output,
+                        const CodecTables& tables);
+  void encodeBlocksAvx512(const uint8_t* input, size_t blocksCount, char* output,
+                          const CodecTables& tables);
+  size_t decodeBlocksSse41(const uint8_t* input, size_t inputLen, uint8_t* output,
+                           const CodecTables& tables);
+  size_t decodeBlocksAvx2(const uint8_t* input, size_t inputLen, uint8_t* output,
+                          const CodecTables& tables);
+  size_t decodeBlocksAvx512(const uint8_t* input, size_t inputLen, uint8_t* output,
+                            const CodecTables& tables);
+  size_t scanCharsSse41(const uint8_t* input, size_t inputLen, const CodecTables& tables,
+                        size_t& payloadChars);
+  size_t scanCharsAvx2(const uint8_t* input, size_t inputLen, const CodecTables& tables,
+                       size_t& payloadChars);
+  size_t scanCharsAvx512(const uint8_t* input, size_t inputLen, const CodecTables& tables,
+                         size_t& payloadChars);
+#endif
+
+#if defined(BASE32_ARCH_ARM64)
+  void encodeBlocksNeon(const uint8_t* input, size_t blocksCount, char* output,
+                        const CodecTables& tables);
+  size_t decodeBlocksNeon(const uint8_t* input, size_t inputLen, uint8_t* output,
+                          const CodecTables& tables);
+  size_t scanCharsNeon(const uint8_t* input, size_t inputLen, const CodecTables& tables,
+                       size_t& payloadChars);
+#endif
+}  // namespace base32::detail
@@ -0,0 +1,153 @@
+#include "kernels.hpp"
+
+#if defined(BASE32_ARCH_ARM64)
+
+#  include <arm_neon.h>
+
+#  include <cstddef>
+#  include <cstdint>
+#  include <cstring>
+
+namespace {
+  using base32::detail::gBytesPerB32Block;
+  using base32::detail::gCharsPerB32Block;
+  using base32::detail::gB32AlphabetSize;
+  using base32::detail::gSkipChar;
+
+  /*!
+   * \brief gEncodeShuffle
+   *
+   * Every 16 bits lane gets 2 adjacent bytes of a block containing one encoded character,
+   * first byte becomes most significant one. Character i starts at bit 5*i of the block.
+   */
+  constexpr uint8_t gEncodeShuffle[16] = {1, 0, 1, 0, 2, 1, 2, 1, 3, 2, 4, 3, 4, 3, 5, 4};
+
+  /*!
+   * \brief gEncodeShifts
+   *
+   * character i is shifted right by 11 - (5*i)%8 bits, negative shift of vshlq shifts right
+   */
+  constexpr int16_t gEncodeShifts[8] = {-11, -6, -9, -4, -7, -10, -5, -8};
+
+  /*!
+   * \brief gNeonBlocks
+   *
+   * two blocks are encoded per 128 bits register, 16 bytes are loaded to get them
+   */
+  constexpr size_t gNeonBlocks = 2;
+  constexpr size_t gNeonLoadBytes = 16;
+  constexpr size_t gNeonDecodeChars = 16;
+
+  /*!
+   * \brief gDecodeBlocksShuffle
+   *
+   * takes two 40 bits numbers of 64 bits lanes as 10 bytes, most significant byte first
+   */
+  constexpr uint8_t gDecodeBlocksShuffle[16] = {4, 3, 2, 1, 0, 12, 11, 10, 9, 8, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+  inline uint16x8_t encodeValues(uint8x16_t input, uint8x16_t shuffle, int16x8_t shifts) {
+    const uint16x8_t lanes = vreinterpretq_u16_u8(vqtbl1q_u8(input, shuffle));
+
+    return vandq_u16(vshlq_u16(lanes, shifts), vdupq_n_u16(0x1F));
+  }
+
+  /*!
+   * \brief lookup
+   * \return positions in alphabet, any value above 31 marks an invalid char
+   */
+  inline uint8x16_t lookup(uint8x16_t chars, const uint8x16x4_t& tableLow, const uint8x16x4_t& tableHigh) {
+    const uint8x16_t low = vqtbl4q_u8(tableLow, chars);
+    const uint8x16_t high = vqtbl4q_u8(tableHigh, vsubq_u8(chars, vdupq_n_u8(64)));
+    const uint8x16_t nonAscii = vandq_u8(chars, vdupq_n_u8(0x80));
+
+    return vorrq_u8(vorrq_u8(low, high), nonAscii);
+  }
+
+  /*!
+   * \brief packBlocks
+   * \return two 40 bits numbers in 64 bits lanes
+   */
+  inline uint64x2_t packBlocks(uint8x16_t values) {
+    const uint8x8_t evenChars = vget_low_u8(vuzp1q_u8(values, values));
+    const uint8x8_t oddChars = vget_low_u8(vuzp2q_u8(values, values));
+    const uint16x8_t pairs = vorrq_u16(vshll_n_u8(evenChars, 5), vmovl_u8(oddChars));
+
+    const uint16x4_t evenPairs = vget_low_u16(vuzp1q_u16(pairs, pairs));
+    const uint16x4_t oddPairs = vget_low_u16(vuzp2q_u16(pairs, pairs));
+    const uint32x4_t quads = vorrq_u32(vshll_n_u16(evenPairs, 10), vmovl_u16(oddPairs));
+
+    const uint32x2_t evenQuads = vget_low_u32(vuzp1q_u32(quads, quads));
+    const uint32x2_t oddQuads = vget_low_u32(vuzp2q_u32(quads, quads));
+
+    return vorrq_u64(vshll_n_u32(evenQuads, 20), vmovl_u32(oddQuads));
+  }
+}
+
+namespace base32::detail {
+  void encodeBlocksNeon(const uint8_t* input, size_t blocksCount, char* output,
+                        const CodecTables& tables) {
+    const auto* alphabet = reinterpret_cast<const uint8_t*>(tables.alphabet.data());
+    const uint8x16x2_t alphabetTable{{vld1q_u8(alphabet), vld1q_u8(alphabet + gB32AlphabetSize / 2)}};
+    const uint8x16_t shuffleFirst = vld1q_u8(gEncodeShuffle);
+    const uint8x16_t shuffleSecond = vaddq_u8(shuffleFirst, vdupq_n_u8(gBytesPerB32Block));
+    const int16x8_t shifts = vld1q_s16(gEncodeShifts);
+
+    const size_t inputLen = blocksCount*gBytesPerB32Block;
+    size_t i = 0;
+    for (; i + gNeonLoadBytes <= inputLen; i += gNeonBlocks*gBytesPerB32Block) {
+      const uint8x16_t blocks = vld1q_u8(input + i);
+      const uint8x16_t values = vcombine_u8(vmovn_u16(encodeValues(blocks, shuffleFirst, shifts)),
+                                            vmovn_u16(encodeValues(blocks, shuffleSecond, shifts)));
+      vst1q_u8(reinterpret_cast<uint8_t*>(output), vqtbl2q_u8(alphabetTable, values));
+      output += gNeonBlocks*gCharsPerB32Block;
+    }
+
+    encodeBlocksScalar(input + i, (inputLen - i) / gBytesPerB32Block, output, tables);
+  }
+
+  size_t decodeBlocksNeon(const uint8_t* input, size_t inputLen, uint8_t* output,
+                          const CodecTables& tables) {
+    const uint8_t* table = tables.decode.data();
+    const uint8x16x4_t tableLow{{vld1q_u8(table), vld1q_u8(table + 16), vld1q_u8(table + 32), vld1q_u8(table + 48)}};
+    const uint8x16x4_t tableHigh{{vld1q_u8(table + 64), vld1q_u8(table + 80), vld1q_u8(table + 96), vld1q_u8(table + 112)}};
+    const uint8x16_t blocksShuffle = vld1q_u8(gDecodeBlocksShuffle);
+
+    size_t i = 0;
+    for (; i + gNeonDecodeChars <= inputLen; i += gNeonDecodeChars) {
+      const uint8x16_t values = lookup(vld1q_u8(input + i), tableLow, tableHigh);
+      if (vmaxvq_u8(values) >= gB32AlphabetSize) {
+        break;
+      }
+
+      const uint8x16_t bytes = vqtbl1q_u8(vreinterpretq_u8_u64(packBlocks(values)), blocksShuffle);
+      vst1_u8(output, vget_low_u8(bytes));
+      const uint16_t lastBytes = vgetq_lane_u16(vreinterpretq_u16_u8(bytes), 4);
+      std::memcpy(output + 8, &lastBytes, sizeof(lastBytes));
+      output += 2*gBytesPerB32Block;
+    }
+
+    return i + decodeBlocksScalar(input + i, inputLen - i, output, tables);
+  }
+
+  size_t scanCharsNeon(const uint8_t* input, size_t inputLen, const CodecTables& tables,
+                       size_t& payloadChars) {
+    const uint8_t* table = tables.decode.data();
+    const uint8x16x4_t tableLow{{vld1q_u8(table), vld1q_u8(table + 16), vld1q_u8(table + 32), vld1q_u8(table + 48)}};
+    const uint8x16x4_t tableHigh{{vld1q_u8(table + 64), vld1q_u8(table + 80), vld1q_u8(table + 96), vld1q_u8(table + 112)}};
+
+    size_t i = 0;
+    for (; i + gNeonDecodeChars <= inputLen; i += gNeonDecodeChars) {
+      const uint8x16_t values = lookup(vld1q_u8(input + i), tableLow, tableHigh);
+      const uint8x16_t alphabet = vcltq_u8(values, vdupq_n_u8(gB32AlphabetSize));
+      const uint8x16_t skipped = vceqq_u8(values, vdupq_n_u8(gSkipChar));
+      if (vminvq_u8(vorrq_u8(alphabet, skipped)) == 0) {
+        return i;
+      }
+      payloadChars += vaddvq_u8(vandq_u8(alphabet, vdupq_n_u8(1)));
+    }
+
+    return i;
+  }
+}  // namespace base32::detail
+
+#endif
@@ -0,0 +1,57 @@
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace base32::detail {
+  void encodeBlocksScalar(const uint8_t* input, size_t blocksCount, char* output,
+                          const CodecTables& tables) {
+    for (size_t i = 0; i < blocksCount; ++i) {
+      encodeBlock(input, output, tables);
+      input += gBytesPerB32Block;
+      output += gCharsPerB32Block;
+    }
+  }
+
+  size_t decodeBlocksScalar(const uint8_t* input, size_t inputLen, uint8_t* output,
+                            const CodecTables& tables) {
+    size_t i = 0;
+    while (inputLen - i >= gCharsPerB32Block && decodeBlock(input + i, output, tables)) {
+      i += gCharsPerB32Block;
+      output += gBytesPerB32Block;
+    }
+
+    return i;
+  }
+
+  size_t scanCharsScalar(const uint8_t* input, size_t inputLen, const CodecTables& tables,
+                         size_t& payloadChars) {
+    size_t i = 0;
+    while (i < inputLen) {
+      if (inputLen - i >= gCharsPerB32Block) {
+        uint8_t invalidBits = 0;
+        for (uint8_t k = 0; k < gCharsPerB32Block; ++k) {
+          invalidBits |= tables.decode[input[i + k]];
+        }
+        if ((invalidBits & ~uint8_t{gB32AlphabetSize - 1}) == 0) {
+          payloadChars += gCharsPerB32Block;
+          i += gCharsPerB32Block;
+          continue;
+        }
+      }
+
+      // chunk with skipped or invalid characters
+      const size_t chunkEnd = std::min(inputLen, i + gCharsPerB32Block);
+      for (; i < chunkEnd; ++i) {
+        const uint8_t value = tables.decode[input[i]];
+        if (value == gInvalidChar) {
+          return i;
+        }
+        payloadChars += value < gB32AlphabetSize ? 1 : 0;
+      }
+    }
+
+    return i;
+  }
+}  // namespace base32::detail
@@ -0,0 +1,470 @@
+#include "kernels.hpp"
+
+#if defined(BASE32_ARCH_X86)
+
+// GCC 12 reports _mm512_undefined_epi32 of its own AVX-512 headers as uninitialized, GCC bug 105593
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic ignored "-Wuninitialized"
+#    pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#  endif
+
+#  include <immintrin.h>
+
+#  include <array>
+#  include <bit>
+#  include <cstddef>
+#  include <cstdint>
+#  include <cstring>
+
+#  if defined(__GNUC__) || defined(__clang__)
+#    define BASE32_TARGET(arch) __attribute__((target(arch)))
+#  else
+#    define BASE32_TARGET(arch)
+#  endif
+
+namespace {
+  using base32::detail::gBytesPerB32Block;
+  using base32::detail::gCharsPerB32Block;
+  using base32::detail::CodecTables;
+  using base32::detail::gSkipChar;
+
+  /*!
+   * \brief gEncodeShuffle
+   *
+   * Every 16 bits lane gets 2 adjacent bytes of a block containing one encoded character,
+   * first byte becomes most significant one. Character i starts at bit 5*i of the block.
+   */
+  constexpr int8_t gEncodeShuffle[16] = {1, 0, 1, 0, 2, 1, 2, 1, 3, 2, 4, 3, 4, 3, 5, 4};
+
+  /*!
+   * \brief gEncodeMultipliers
+   *
+   * character i is shifted right by 11 - (5*i)%8 bits, mulhi by 2^(16 - shift) does it for all lanes at once
+   */
+  constexpr int16_t gEncodeMultipliers[8] = {1 << 5, 1 << 10, 1 << 7, 1 << 12, 1 << 9, 1 << 6, 1 << 11, 1 << 8};
+
+  /*!
+   * \brief gSseBlocks
+   *
+   * two blocks are encoded per 128 bits register, 16 bytes are loaded to get them
+   */
+  constexpr size_t gSseBlocks = 2;
+  constexpr size_t gSseLoadBytes = 16;
+
+  /*!
+   * \brief gAvx2Blocks
+   *
+   * four blocks are encoded per 256 bits register, second lane is loaded from the third block
+   */
+  constexpr size_t gAvx2Blocks = 4;
+  constexpr size_t gAvx2LoadBytes = 2*gBytesPerB32Block + 16;
+
+  BASE32_TARGET("sse4.1")
+  inline __m128i encodeValuesSse41(__m128i input) {
+    const __m128i shuffleFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(gEncodeShuffle));
+    const __m128i shuffleSecond = _mm_add_epi8(shuffleFirst, _mm_set1_epi8(gBytesPerB32Block));
+    const __m128i multipliers = _mm_loadu_si128(reinterpret_cast<const __m128i*>(gEncodeMultipliers));
+    const __m128i mask = _mm_set1_epi16(0x1F);
+
+    const __m128i first = _mm_and_si128(_mm_mulhi_epu16(_mm_shuffle_epi8(input, shuffleFirst), multipliers), mask);
+    const __m128i second = _mm_and_si128(_mm_mulhi_epu16(_mm_shuffle_epi8(input, shuffleSecond), multipliers), mask);
+
+    return _mm_packus_epi16(first, second);
+  }
+
+  BASE32_TARGET("sse4.1")
+  inline __m128i mapAlphabetSse41(__m128i values, __m128i alphabetLow, __m128i alphabetHigh) {
+    const __m128i low = _mm_shuffle_epi8(alphabetLow, values);
+    const __m128i high = _mm_shuffle_epi8(alphabetHigh, values);
+
+    return _mm_blendv_epi8(low, high, _mm_cmpgt_epi8(values, _mm_set1_epi8(15)));
+  }
+
+  BASE32_TARGET("avx2")
+  inline __m256i encodeValuesAvx2(__m256i input) {
+    const __m256i shuffleFirst = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(gEncodeShuffle)));
+    const __m256i shuffleSecond = _mm256_add_epi8(shuffleFirst, _mm256_set1_epi8(gBytesPerB32Block));
+    const __m256i multipliers = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(gEncodeMultipliers)));
+    const __m256i mask = _mm256_set1_epi16(0x1F);
+
+    const __m256i first = _mm256_and_si256(_mm256_mulhi_epu16(_mm256_shuffle_epi8(input, shuffleFirst), multipliers), mask);
+    const __m256i second = _mm256_and_si256(_mm256_mulhi_epu16(_mm256_shuffle_epi8(input, shuffleSecond), multipliers), mask);
+
+    return _mm256_packus_epi16(first, second);
+  }
+
+  BASE32_TARGET("avx2")
+  inline __m256i mapAlphabetAvx2(__m256i values, __m256i alphabetLow, __m256i alphabetHigh) {
+    const __m256i low = _mm256_shuffle_epi8(alphabetLow, values);
+    const __m256i high = _mm256_shuffle_epi8(alphabetHigh, values);
+
+    return _mm256_blendv_epi8(low, high, _mm256_cmpgt_epi8(values, _mm256_set1_epi8(15)));
+  }
+
+  /*!
+   * \brief gAvx512Blocks
+   *
+   * eight blocks per 512 bits register, loads and stores are masked so nothing is read or written past the blocks
+   */
+  constexpr size_t gAvx512Blocks = 8;
+  constexpr uint64_t gAvx512BlocksBytesMask = (uint64_t{1} << (gAvx512Blocks*gBytesPerB32Block)) - 1;
+
+  /*!
+   * \brief gAvx512EncodeMultishift
+   *
+   * every byte of 64 bits lane takes 8 bits starting from 35 - 5*i, the block is stored in lane as little endian 40 bits number
+   */
+  constexpr uint64_t gAvx512EncodeMultishift = 0x00050A0F14191E23ULL;
+
+  /*!
+   * \brief buildAvx512BlockSpread
+   *
+   * byte permutation moving 5 bytes block i into 64 bits lane i, least significant byte first
+   * \return
+   */
+  constexpr std::array<uint8_t, 64> buildAvx512BlockSpread() {
+    std::array<uint8_t, 64> permutation{};
+    for (size_t block = 0; block < gAvx512Blocks; ++block) {
+      for (size_t k = 0; k < gBytesPerB32Block; ++k) {
+        permutation.at(block*8 + k) = static_cast<uint8_t>(block*gBytesPerB32Block + gBytesPerB32Block - 1 - k);
+      }
+    }
+
+    return permutation;
+  }
+
+  constexpr std::array<uint8_t, 64> gAvx512BlockSpread = buildAvx512BlockSpread();
+
+  /*!
+   * \brief buildAvx512BlockGather
+   *
+   * inverse of gAvx512BlockSpread, collects 40 bits numbers of 64 bits lanes as 5 bytes blocks
+   * \return
+   */
+  constexpr std::array<uint8_t, 64> buildAvx512BlockGather() {
+    std::array<uint8_t, 64> permutation{};
+    for (size_t block = 0; block < gAvx512Blocks; ++block) {
+      for (size_t k = 0; k < gBytesPerB32Block; ++k) {
+        permutation.at(block*gBytesPerB32Block + k) = static_cast<uint8_t>(block*8 + gBytesPerB32Block - 1 - k);
+      }
+    }
+
+    return permutation;
+  }
+
+  constexpr std::array<uint8_t, 64> gAvx512BlockGather = buildAvx512BlockGather();
+
+  /*!
+   * \brief gDecodeBlocksShuffle
+   *
+   * takes two 40 bits numbers of 64 bits lanes as 10 bytes, most significant byte first
+   */
+  constexpr int8_t gDecodeBlocksShuffle[16] = {4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1};
+
+  /*!
+   * \brief gDecodePairMultipliers
+   *
+   * multipliers for maddubs and madd to merge 5 bits values into 10 and then 20 bits values
+   */
+  constexpr int16_t gDecodePairMultipliers = 0x0120;
+  constexpr int32_t gDecodeQuadMultipliers = 0x00010400;
+
+  constexpr uint8_t gDecodeRows = 8;
+  constexpr size_t gSseDecodeChars = 16;
+  constexpr size_t gAvx2DecodeChars = 32;
+  constexpr size_t gAvx512DecodeChars = 64;
+
+  /*!
+   * \brief SseDecodeRows
+   *
+   * first 128 entries of decode table as 16 bytes rows selected by high nibble of a char,
+   * chars above 127 are never valid and rejected by their sign bit
+   */
+  struct SseDecodeRows {
+    __m128i rows[gDecodeRows];
+  };
+
+  BASE32_TARGET("sse4.1")
+  inline SseDecodeRows loadDecodeRowsSse41(const CodecTables& tables) {
+    SseDecodeRows rows{};
+    for (uint8_t k = 0; k < gDecodeRows; ++k) {
+      rows.rows[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.decode.data() + 16*k));
+    }
+
+    return rows;
+  }
+
+  /*!
+   * \brief lookupSse41
+   * \return positions in alphabet, any value with sign bit set marks an invalid char
+   */
+  BASE32_TARGET("sse4.1")
+  inline __m128i lookupSse41(__m128i chars, const SseDecodeRows& rows) {
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+    const __m128i low = _mm_and_si128(chars, nibbleMask);
+    const __m128i high = _mm_and_si128(_mm_srli_epi16(chars, 4), nibbleMask);
+
+    __m128i values = _mm_and_si128(chars, _mm_set1_epi8(static_cast<char>(0x80)));
+    for (uint8_t k = 0; k < gDecodeRows; ++k) {
+      const __m128i row = _mm_shuffle_epi8(rows.rows[k], low);
+      values = _mm_or_si128(values, _mm_and_si128(_mm_cmpeq_epi8(high, _mm_set1_epi8(static_cast<char>(k))), row));
+    }
+
+    return values;
+  }
+
+  /*!
+   * \brief packBlocksSse41
+   * \return two 40 bits numbers in 64 bits lanes
+   */
+  BASE32_TARGET("sse4.1")
+  inline __m128i packBlocksSse41(__m128i values) {
+    const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi16(gDecodePairMultipliers));
+    const __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(gDecodeQuadMultipliers));
+
+    return _mm_or_si128(_mm_srli_epi64(quads, 32), _mm_srli_epi64(_mm_slli_epi64(quads, 32), 12));
+  }
+
+  struct Avx2DecodeRows {
+    __m256i rows[gDecodeRows];
+  };
+
+  BASE32_TARGET("avx2")
+  inline Avx2DecodeRows loadDecodeRowsAvx2(const CodecTables& tables) {
+    Avx2DecodeRows rows{};
+    for (uint8_t k = 0; k < gDecodeRows; ++k) {
+      rows.rows[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.decode.data() + 16*k)));
+    }
+
+    return rows;
+  }
+
+  BASE32_TARGET("avx2")
+  inline __m256i lookupAvx2(__m256i chars, const Avx2DecodeRows& rows) {
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+    const __m256i low = _mm256_and_si256(chars, nibbleMask);
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi16(chars, 4), nibbleMask);
+
+    __m256i values = _mm256_and_si256(chars, _mm256_set1_epi8(static_cast<char>(0x80)));
+    for (uint8_t k = 0; k < gDecodeRows; ++k) {
+      const __m256i row = _mm256_shuffle_epi8(rows.rows[k], low);
+      values = _mm256_or_si256(values, _mm256_and_si256(_mm256_cmpeq_epi8(high, _mm256_set1_epi8(static_cast<char>(k))), row));
+    }
+
+    return values;
+  }
+
+  BASE32_TARGET("avx2")
+  inline __m256i packBlocksAvx2(__m256i values) {
+    const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi16(gDecodePairMultipliers));
+    const __m256i quads = _mm256_madd_epi16(pairs, _mm256_set1_epi32(gDecodeQuadMultipliers));
+
+    return _mm256_or_si256(_mm256_srli_epi64(quads, 32), _mm256_srli_epi64(_mm256_slli_epi64(quads, 32), 12));
+  }
+}
+
+namespace base32::detail {
+  BASE32_TARGET("sse4.1")
+  void encodeBlocksSse41(const uint8_t* input, size_t blocksCount, char* output,
+                         const CodecTables& tables) {
+    const __m128i alphabetLow = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.alphabet.data()));
+    const __m128i alphabetHigh = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.alphabet.data() + 16));
+
+    const size_t inputLen = blocksCount*gBytesPerB32Block;
+    size_t i = 0;
+    for (; i + gSseLoadBytes <= inputLen; i += gSseBlocks*gBytesPerB32Block) {
+      const __m128i values = encodeValuesSse41(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output), mapAlphabetSse41(values, alphabetLow, alphabetHigh));
+      output += gSseBlocks*gCharsPerB32Block;
+    }
+
+    encodeBlocksScalar(input + i, (inputLen - i) / gBytesPerB32Block, output, tables);
+  }
+
+  BASE32_TARGET("avx2")
+  void encodeBlocksAvx2(const uint8_t* input, size_t blocksCount, char* output,
+                        const CodecTables& tables) {
+    const __m256i alphabetLow = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.alphabet.data())));
+    const __m256i alphabetHigh = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.alphabet.data() + 16)));
+
+    const size_t inputLen = blocksCount*gBytesPerB32Block;
+    size_t i = 0;
+    for (; i + gAvx2LoadBytes <= inputLen; i += gAvx2Blocks*gBytesPerB32Block) {
+      const __m128i firstLane = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+      const __m128i secondLane = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 2*gBytesPerB32Block));
+      const __m256i values = encodeValuesAvx2(_mm256_inserti128_si256(_mm256_castsi128_si256(firstLane), secondLane, 1));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), mapAlphabetAvx2(values, alphabetLow, alphabetHigh));
+      output += gAvx2Blocks*gCharsPerB32Block;
+    }
+
+    encodeBlocksSse41(input + i, (inputLen - i) / gBytesPerB32Block, output, tables);
+  }
+
+  BASE32_TARGET("avx512f,avx512bw,avx512vbmi")
+  void encodeBlocksAvx512(const uint8_t* input, size_t blocksCount, char* output,
+                          const CodecTables& tables) {
+    const __m512i alphabet = _mm512_broadcast_i64x4(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(tables.alphabet.data())));
+    const __m512i spread = _mm512_loadu_si512(gAvx512BlockSpread.data());
+    const __m512i multishift = _mm512_set1_epi64(static_cast<int64_t>(gAvx512EncodeMultishift));
+    const __m512i mask = _mm512_set1_epi8(0x1F);
+
+    size_t i = 0;
+    for (; i + gAvx512Blocks <= blocksCount; i += gAvx512Blocks) {
+      const __m512i blocks = _mm512_maskz_loadu_epi8(gAvx512BlocksBytesMask, input);
+      const __m512i lanes = _mm512_permutexvar_epi8(spread, blocks);
+      const __m512i values = _mm512_and_si512(_mm512_multishift_epi64_epi8(multishift, lanes), mask);
+      _mm512_storeu_si512(output, _mm512_permutexvar_epi8(values, alphabet));
+      input += gAvx512Blocks*gBytesPerB32Block;
+      output += gAvx512Blocks*gCharsPerB32Block;
+    }
+
+    encodeBlocksAvx2(input, blocksCount - i, output, tables);
+  }
+
+  BASE32_TARGET("sse4.1")
+  size_t decodeBlocksSse41(const uint8_t* input, size_t inputLen, uint8_t* output,
+                           const CodecTables& tables) {
+    const SseDecodeRows rows = loadDecodeRowsSse41(tables);
+    const __m128i blocksShuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(gDecodeBlocksShuffle));
+
+    size_t i = 0;
+    for (; i + gSseDecodeChars <= inputLen; i += gSseDecodeChars) {
+      const __m128i values = lookupSse41(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)), rows);
+      if (_mm_movemask_epi8(values) != 0) {
+        break;
+      }
+
+      const __m128i bytes = _mm_shuffle_epi8(packBlocksSse41(values), blocksShuffle);
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(output), bytes);
+      const auto lastBytes = static_cast<uint16_t>(_mm_extract_epi16(bytes, 4));
+      std::memcpy(output + 8, &lastBytes, sizeof(lastBytes));
+      output += 2*gBytesPerB32Block;
+    }
+
+    return i + decodeBlocksScalar(input + i, inputLen - i, output, tables);
+  }
+
+  BASE32_TARGET("avx2")
+  size_t decodeBlocksAvx2(const uint8_t* input, size_t inputLen, uint8_t* output,
+                          const CodecTables& tables) {
+    const Avx2DecodeRows rows = loadDecodeRowsAvx2(tables);
+    const __m256i blocksShuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(gDecodeBlocksShuffle)));
+
+    size_t i = 0;
+    for (; i + gAvx2DecodeChars <= inputLen; i += gAvx2DecodeChars) {
+      const __m256i values = lookupAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i)), rows);
+      if (_mm256_movemask_epi8(values) != 0) {
+        return i + decodeBlocksScalar(input + i, inputLen - i, output, tables);
+      }
+
+      const __m256i bytes = _mm256_shuffle_epi8(packBlocksAvx2(values), blocksShuffle);
+      const __m128i secondLane = _mm256_extracti128_si256(bytes, 1);
+      const __m128i first16 = _mm_or_si128(_mm256_castsi256_si128(bytes), _mm_slli_si128(secondLane, 10));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output), first16);
+      const auto last4 = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(secondLane, 6)));
+      std::memcpy(output + 16, &last4, sizeof(last4));
+      output += 4*gBytesPerB32Block;
+    }
+
+    // narrower kernels take over only the tail shorter than one iteration, after an invalid chunk
+    // they would fail on the same character and just repeat the lookup
+    return i + decodeBlocksSse41(input + i, inputLen - i, output, tables);
+  }
+
+  BASE32_TARGET("avx512f,avx512bw,avx512vbmi")
+  size_t decodeBlocksAvx512(const uint8_t* input, size_t inputLen, uint8_t* output,
+                            const CodecTables& tables) {
+    const __m512i tableLow = _mm512_loadu_si512(tables.decode.data());
+    const __m512i tableHigh = _mm512_loadu_si512(tables.decode.data() + 64);
+    const __m512i gather = _mm512_loadu_si512(gAvx512BlockGather.data());
+    const __m512i pairMultipliers = _mm512_set1_epi16(gDecodePairMultipliers);
+    const __m512i quadMultipliers = _mm512_set1_epi32(gDecodeQuadMultipliers);
+
+    size_t i = 0;
+    for (; i + gAvx512DecodeChars <= inputLen; i += gAvx512DecodeChars) {
+      const __m512i chars = _mm512_loadu_si512(input + i);
+      const __m512i values = _mm512_permutex2var_epi8(tableLow, chars, tableHigh);
+      if (_mm512_movepi8_mask(_mm512_or_si512(values, chars)) != 0) {
+        return i + decodeBlocksScalar(input + i, inputLen - i, output, tables);
+      }
+
+      const __m512i quads = _mm512_madd_epi16(_mm512_maddubs_epi16(values, pairMultipliers), quadMultipliers);
+      const __m512i lanes = _mm512_or_si512(_mm512_srli_epi64(quads, 32), _mm512_srli_epi64(_mm512_slli_epi64(quads, 32), 12));
+      _mm512_mask_storeu_epi8(output, gAvx512BlocksBytesMask, _mm512_permutexvar_epi8(gather, lanes));
+      output += gAvx512Blocks*gBytesPerB32Block;
+    }
+
+    return i + decodeBlocksAvx2(input + i, inputLen - i, output, tables);
+  }
+
+  BASE32_TARGET("sse4.1")
+  size_t scanCharsSse41(const uint8_t* input, size_t inputLen, const CodecTables& tables,
+                        size_t& payloadChars) {
+    const SseDecodeRows rows = loadDecodeRowsSse41(tables);
+    const __m128i skipValues = _mm_set1_epi8(static_cast<char>(gSkipChar));
+
+    size_t i = 0;
+    for (; i + gSseDecodeChars <= inputLen; i += gSseDecodeChars) {
+      const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+      const __m128i values = lookupSse41(chars, rows);
+      // high nibble of non ASCII chars selects no table row, lookup leaves only their sign bit, so they are
+      // invalid and never equal to skipped value, excluding them from skipped chars only mirrors the AVX-512 scan
+      const auto skipMask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(values, skipValues))
+                                                  & ~_mm_movemask_epi8(chars));
+      const auto notAlphabetMask = static_cast<unsigned>(_mm_movemask_epi8(values));
+      if ((notAlphabetMask & ~skipMask) != 0) {
+        return i;
+      }
+      payloadChars += gSseDecodeChars - static_cast<size_t>(std::popcount(notAlphabetMask));
+    }
+
+    return i;
+  }
+
+  BASE32_TARGET("avx2")
+  size_t scanCharsAvx2(const uint8_t* input, size_t inputLen, const CodecTables& tables,
+                       size_t& payloadChars) {
+    const Avx2DecodeRows rows = loadDecodeRowsAvx2(tables);
+    const __m256i skipValues = _mm256_set1_epi8(static_cast<char>(gSkipChar));
+
+    size_t i = 0;
+    for (; i + gAvx2DecodeChars <= inputLen; i += gAvx2DecodeChars) {
+      const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+      const __m256i values = lookupAvx2(chars, rows);
+      const auto skipMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(values, skipValues))
+                                                  & ~_mm256_movemask_epi8(chars));
+      const auto notAlphabetMask = static_cast<uint32_t>(_mm256_movemask_epi8(values));
+      if ((notAlphabetMask & ~skipMask) != 0) {
+        return i;
+      }
+      payloadChars += gAvx2DecodeChars - static_cast<size_t>(std::popcount(notAlphabetMask));
+    }
+
+    return i + scanCharsSse41(input + i, inputLen - i, tables, payloadChars);
+  }
+
+  BASE32_TARGET("avx512f,avx512bw,avx512vbmi")
+  size_t scanCharsAvx512(const uint8_t* input, size_t inputLen, const CodecTables& tables,
+                         size_t& payloadChars) {
+    const __m512i tableLow = _mm512_loadu_si512(tables.decode.data());
+    const __m512i tableHigh = _mm512_loadu_si512(tables.decode.data() + 64);
+    const __m512i skipValues = _mm512_set1_epi8(static_cast<char>(gSkipChar));
+
+    size_t i = 0;
+    for (; i + gAvx512DecodeChars <= inputLen; i += gAvx512DecodeChars) {
+      const __m512i chars = _mm512_loadu_si512(input + i);
+      const __m512i values = _mm512_permutex2var_epi8(tableLow, chars, tableHigh);
+      const __mmask64 nonAscii = _mm512_movepi8_mask(chars);
+      const __mmask64 skipMask = _mm512_cmpeq_epi8_mask(values, skipValues) & ~nonAscii;
+      const __mmask64 notAlphabetMask = _mm512_movepi8_mask(values) | nonAscii;
+      if ((notAlphabetMask & ~skipMask) != 0) {
+        return i;
+      }
+      payloadChars += gAvx512DecodeChars - static_cast<size_t>(std::popcount(notAlphabetMask));
+    }
+
+    return i + scanCharsAvx2(input + i, inputLen - i, tables, payloadChars);
+  }
+}  // namespace base32::detail
+
+#endif
@@ -0,0 +1,131 @@
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+  using base32::detail::gBytesPerB32Block;
+  using base32::detail::gCharsPerB32Block;
+
+  /*!
+   * \brief gMinBlocksPerSlice
+   *
+   * Blocks are 5 input bytes of encode and 8 input characters of decode, so a thread gets at least 256 KB
+   * of encode input or 410 KB of decode input, both 52K blocks. Smaller slices don't pay off thread start.
+   */
+  constexpr size_t gMinBlocksPerSlice = 256ULL * 1024 / gBytesPerB32Block;
+
+  /*!
+   * \brief slicesCount
+   * \param blocksCount
+   * \param threads requested number of threads, 0 for hardware concurrency
+   * \return number of slices to split blocksCount blocks into
+   */
+  size_t slicesCount(size_t blocksCount, unsigned threads) {
+    const size_t requested = threads == 0 ? std::max(1U, std::thread::hardware_concurrency()) : threads;
+
+    return std::clamp<size_t>(blocksCount / gMinBlocksPerSlice, 1, requested);
+  }
+
+  /*!
+   * \brief forEachSlice
+   *
+   * Run job for every slice of blocksCount blocks, the last slice is processed by calling thread
+   * \param blocksCount
+   * \param slices
+   * \param job callable taking first block and number of blocks of a slice
+   */
+  template <typename Job>
+  void forEachSlice(size_t blocksCount, size_t slices, const Job& job) {
+    const size_t blocksPerSlice = blocksCount / slices;
+    {
+      std::vector<std::jthread> workers;
+      workers.reserve(slices - 1);
+      for (size_t slice = 0; slice + 1 < slices; ++slice) {
+        workers.emplace_back(job, slice*blocksPerSlice, blocksPerSlice);
+      }
+
+      const size_t lastBlock = (slices - 1)*blocksPerSlice;
+      job(lastBlock, blocksCount - lastBlock);
+    }
+  }
+}
+
+namespace base32::detail {
+  void encodeBlocksParallel(const uint8_t* input, size_t blocksCount, char* output,
+                            const CodecTables& tables, unsigned threads) {
+    const EncodeKernel encode = activeKernels().encode;
+    forEachSlice(blocksCount, slicesCount(blocksCount, threads), [&](size_t firstBlock, size_t blocks) {
+      encode(input + firstBlock*gBytesPerB32Block, blocks, output + firstBlock*gCharsPerB32Block, tables);
+    });
+  }
+
+  bool decodeCharsParallel(const uint8_t* input, size_t inputLen, uint8_t* output, size_t& written,
+                           size_t& payloadChars, const CodecTables& tables, unsigned threads) {
+    const size_t blocksCount = inputLen / gCharsPerB32Block;
+    const size_t slices = slicesCount(blocksCount, threads);
+    if (slices == 1) {
+      return false;
+    }
+
+    // scanning is cheaper than decoding, invalid input is left to sequential decoding before anything is decoded
+    const size_t blocksPerSlice = blocksCount / slices;
+    const auto sliceEnd = [&](size_t slice) {
+      return slice + 1 == slices ? inputLen : (slice + 1)*blocksPerSlice*gCharsPerB32Block;
+    };
+    std::vector<size_t> slicePayload(slices, 0);
+    std::vector<uint8_t> valid(slices, 0);
+    forEachSlice(blocksCount, slices, [&](size_t firstBlock, size_t /*blocks*/) {
+      const size_t slice = firstBlock / blocksPerSlice;
+      const size_t first = firstBlock*gCharsPerB32Block;
+      const size_t sliceChars = sliceEnd(slice) - first;
+      valid[slice] = static_cast<uint8_t>(scanChars(input + first, sliceChars, slicePayload[slice], tables)
+                                          == sliceChars);
+    });
+    if (!std::ranges::all_of(valid, [](uint8_t sliceValid) { return sliceValid != 0; })) {
+      return false;
+    }
+
+    // skipped characters shift block boundaries, a slice starts after as many payload characters as complete
+    // the block of preceding slices
+    std::vector<size_t> starts(slices + 1, inputLen);
+    std::vector<size_t> payloadBefore(slices + 1, 0);
+    starts[0] = 0;
+    for (size_t slice = 1; slice < slices; ++slice) {
+      payloadBefore[slice] = payloadBefore[slice - 1] + slicePayload[slice - 1];
+      size_t missing = (gCharsPerB32Block - payloadBefore[slice] % gCharsPerB32Block) % gCharsPerB32Block;
+      if (missing > slicePayload[slice]) {
+        return false;
+      }
+      payloadBefore[slice] += missing;
+      slicePayload[slice] -= missing;
+      size_t position = (slice*blocksPerSlice)*gCharsPerB32Block;
+      for (; missing != 0; ++position) {
+        missing -= tables.decode[input[position]] != gSkipChar ? 1 : 0;
+      }
+      starts[slice] = position;
+    }
+    payloadChars = payloadBefore[slices - 1] + slicePayload[slices - 1];
+
+    size_t lastSliceWritten = 0;
+    forEachSlice(blocksCount, slices, [&](size_t firstBlock, size_t /*blocks*/) {
+      const size_t slice = firstBlock / blocksPerSlice;
+      uint8_t* sliceOutput = output + payloadBefore[slice] / gCharsPerB32Block * gBytesPerB32Block;
+
+      // characters are valid, only the last slice has an incomplete block
+      DecodeState state;
+      size_t sliceWritten = 0;
+      decodeChars(state, input + starts[slice], starts[slice + 1] - starts[slice], sliceOutput, sliceWritten, tables);
+      if (slice + 1 == slices) {
+        lastSliceWritten = sliceWritten + finishDecode(state, sliceOutput + sliceWritten);
+      }
+    });
+
+    written = payloadBefore[slices - 1] / gCharsPerB32Block * gBytesPerB32Block + lastSliceWritten;
+
+    return true;
+  }
+}  // namespace base32::detail
@@ -0,0 +1,113 @@
+#include "base32/stats.hpp"
+
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+  using base32::gBackendsCount;
+  using base32::gErrorsCount;
+  using base32::gLatencyBuckets;
+  using base32::gOperationsCount;
+
+  /*!
+   * \brief The AtomicOperationStats struct
+   *
+   * live counterpart of OperationStats
+   */
+  struct AtomicOperationStats {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> bytesIn{0};
+    std::atomic<uint64_t> bytesOut{0};
+    std::array<std::atomic<uint64_t>, gErrorsCount> errors{};
+    std::array<std::atomic<uint64_t>, gLatencyBuckets> latency{};
+  };
+
+  std::array<std::array<AtomicOperationStats, gOperationsCount>, gBackendsCount> gCounters;
+
+  /*!
+   * \brief gStatsDepth
+   *
+   * number of scopes open on this thread
+   */
+  thread_local size_t gStatsDepth = 0;
+
+  /*!
+   * \brief latencyBucket
+   * \param nanoseconds
+   * \return index of histogram bucket
+   */
+  size_t latencyBucket(uint64_t nanoseconds) {
+    constexpr auto baseWidth = static_cast<size_t>(std::bit_width(base32::gLatencyBucketBaseNs - 1));
+    const auto width = static_cast<size_t>(std::bit_width(nanoseconds));
+
+    return std::min(width > baseWidth ? width - baseWidth : 0, gLatencyBuckets - 1);
+  }
+}
+
+namespace base32 {
+  void detail::recordCall(Operation operation, size_t bytesIn, size_t bytesOut, Error errCode, uint64_t nanoseconds) {
+    auto& counters = gCounters[static_cast<size_t>(activeKernels().backend)][static_cast<size_t>(operation)];
+    counters.calls.fetch_add(1, std::memory_order_relaxed);
+    counters.bytesIn.fetch_add(bytesIn, std::memory_order_relaxed);
+    counters.bytesOut.fetch_add(bytesOut, std::memory_order_relaxed);
+    counters.errors[static_cast<size_t>(errCode)].fetch_add(1, std::memory_order_relaxed);
+    counters.latency[latencyBucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  bool detail::enterStatsScope() {
+    return gStatsDepth++ == 0;
+  }
+
+  void detail::leaveStatsScope() {
+    --gStatsDepth;
+  }
+
+  bool statsEnabled() {
+#if defined(BASE32_ENABLE_STATS)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  Stats statsSnapshot() {
+    Stats stats;
+    for (size_t backend = 0; backend < gBackendsCount; ++backend) {
+      for (size_t operation = 0; operation < gOperationsCount; ++operation) {
+        const auto& counters = gCounters[backend][operation];
+        auto& snapshot = stats.counters[backend][operation];
+        snapshot.calls = counters.calls.load(std::memory_order_relaxed);
+        snapshot.bytesIn = counters.bytesIn.load(std::memory_order_relaxed);
+        snapshot.bytesOut = counters.bytesOut.load(std::memory_order_relaxed);
+        std::ranges::transform(counters.errors, snapshot.errors.begin(),
+                               [](const auto& counter) { return counter.load(std::memory_order_relaxed); });
+        std::ranges::transform(counters.latency, snapshot.latency.begin(),
+                               [](const auto& counter) { return counter.load(std::memory_order_relaxed); });
+      }
+    }
+
+    return stats;
+  }
+
+  void resetStats() {
+    for (auto& backend: gCounters) {
+      for (auto& counters: backend) {
+        counters.calls.store(0, std::memory_order_relaxed);
+        counters.bytesIn.store(0, std::memory_order_relaxed);
+        counters.bytesOut.store(0, std::memory_order_relaxed);
+        for (auto& counter: counters.errors) {
+          counter.store(0, std::memory_order_relaxed);
+        }
+        for (auto& counter: counters.latency) {
+          counter.store(0, std::memory_order_relaxed);
+        }
+      }
+    }
+  }
+}  // namespace base32
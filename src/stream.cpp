@@ -0,0 +1,269 @@
+#include "base32/base32.hpp"
+
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+namespace {
+  using base32::detail::gBytesPerB32Block;
+  using base32::detail::gCharsPerB32Block;
+  using base32::detail::gMaxEncodableInputLen;
+  using base32::detail::gRfc4648Tables;
+  using base32::detail::gSkipChar;
+
+  constexpr char gPaddingChar = '=';
+
+  /*!
+   * \brief isPaddingTail
+   * \param tail rest of input after the first padding character
+   * \return true if tail consists of padding and whitespaces only
+   */
+  bool isPaddingTail(std::string_view tail) {
+    return std::ranges::all_of(tail, [](char chr) {
+      return chr == gPaddingChar || gRfc4648Tables.decode[static_cast<uint8_t>(chr)] == gSkipChar;
+    });
+  }
+
+  /*!
+   * \brief The SegmentWriter class
+   *
+   * Sequential writer over a chain of output segments
+   */
+  template <typename T>
+  class SegmentWriter {
+  public:
+    explicit SegmentWriter(std::span<const std::span<T>> segments) : segments_(segments) {}
+
+    /*!
+     * \brief current
+     * \return free part of the first segment which is not full, empty if all segments are full
+     */
+    std::span<T> current() {
+      while (index_ < segments_.size() && offset_ == segments_[index_].size()) {
+        ++index_;
+        offset_ = 0;
+      }
+
+      return index_ < segments_.size() ? segments_[index_].subspan(offset_) : std::span<T>{};
+    }
+
+    /*!
+     * \brief advance
+     * \param count number of elements written to current(), at most its size
+     */
+    void advance(size_t count) {
+      offset_ += count;
+      written_ += count;
+    }
+
+    /*!
+     * \brief write
+     *
+     * Copy data across segment boundaries
+     * \return false if segments are too small, they are filled as much as possible then
+     */
+    bool write(const T* data, size_t count) {
+      while (count != 0) {
+        const std::span<T> free = current();
+        if (free.empty()) {
+          return false;
+        }
+        const size_t copied = std::min(count, free.size());
+        std::memcpy(free.data(), data, copied);
+        advance(copied);
+        data += copied;
+        count -= copied;
+      }
+
+      return true;
+    }
+
+    [[nodiscard]] size_t written() const {
+      return written_;
+    }
+
+  private:
+    std::span<const std::span<T>> segments_;
+    size_t index_{0};
+    size_t offset_{0};
+    size_t written_{0};
+  };
+}
+
+namespace base32 {
+  size_t Encoder::update(std::span<const uint8_t> chunk, std::span<char> output, Error& errCode) {
+    if (output.size() < updateSize(chunk.size())) {
+      errCode = Error::BufferTooSmall;
+      return 0;
+    }
+
+    char* encoded = output.data();
+    if (pendingCount_ != 0) {
+      const size_t missing = gBytesPerB32Block - pendingCount_;
+      if (chunk.size() < missing) {
+        std::copy_n(chunk.data(), chunk.size(), pending_.data() + pendingCount_);
+        pendingCount_ += static_cast<uint8_t>(chunk.size());
+        errCode = Error::NoError;
+        return 0;
+      }
+
+      std::array<uint8_t, gBytesPerB32Block> block{};
+      std::memcpy(block.data(), pending_.data(), pendingCount_);
+      std::copy_n(chunk.data(), missing, block.data() + pendingCount_);
+      detail::encodeBlock(block.data(), encoded, gRfc4648Tables);
+      encoded += gCharsPerB32Block;
+      chunk = chunk.subspan(missing);
+      pendingCount_ = 0;
+    }
+
+    const size_t fullBlocks = chunk.size() / gBytesPerB32Block;
+    detail::activeKernels().encode(chunk.data(), fullBlocks, encoded, gRfc4648Tables);
+    encoded += fullBlocks*gCharsPerB32Block;
+
+    const size_t tailBytes = chunk.size() % gBytesPerB32Block;
+    // copy_n, as chunk of an empty span may be null
+    std::copy_n(chunk.data() + fullBlocks*gBytesPerB32Block, tailBytes, pending_.data());
+    pendingCount_ = static_cast<uint8_t>(tailBytes);
+
+    errCode = Error::NoError;
+
+    return static_cast<size_t>(encoded - output.data());
+  }
+
+  size_t Encoder::finalize(std::span<char> output, Error& errCode) {
+    if (output.size() < finalizeSize()) {
+      errCode = Error::BufferTooSmall;
+      return 0;
+    }
+
+    const size_t written = detail::encodeTail(pending_.data(), pendingCount_, output.data(), gRfc4648Tables,
+                                              Padding::Enabled);
+    pendingCount_ = 0;
+    errCode = Error::NoError;
+
+    return written;
+  }
+
+  size_t Decoder::update(std::string_view chunk, std::span<uint8_t> output, Error& errCode) {
+    if (output.size() < updateSize(chunk.size())) {
+      errCode = Error::BufferTooSmall;
+      return 0;
+    }
+
+    const size_t payloadChars = padding_ ? 0 : std::min(chunk.find(gPaddingChar), chunk.size());
+    detail::DecodeState state{values_, valuesCount_};
+    size_t written = 0;
+    errCode = detail::decodeChars(state, reinterpret_cast<const uint8_t*>(chunk.data()), payloadChars,
+                                  output.data(), written, gRfc4648Tables);
+    values_ = state.values;
+    valuesCount_ = state.count;
+
+    if (errCode == Error::NoError && payloadChars != chunk.size()) {
+      padding_ = true;
+      if (!isPaddingTail(chunk.substr(payloadChars))) {
+        errCode = Error::InvalidB32Input;
+      }
+    }
+
+    return written;
+  }
+
+  size_t Decoder::finalize(std::span<uint8_t> output, Error& errCode) {
+    if (output.size() < finalizeSize()) {
+      errCode = Error::BufferTooSmall;
+      return 0;
+    }
+
+    detail::DecodeState state{values_, valuesCount_};
+    const size_t written = detail::finishDecode(state, output.data());
+    reset();
+    errCode = Error::NoError;
+
+    return written;
+  }
+
+  void Decoder::reset() {
+    valuesCount_ = 0;
+    padding_ = false;
+  }
+
+  size_t encodeSegments(std::span<const std::span<const uint8_t>> inputs, std::span<const std::span<char>> outputs,
+                        Error& errCode) {
+    size_t inputLength = 0;
+    for (const auto& input: inputs) {
+      if (input.size() > gMaxEncodableInputLen - inputLength) {
+        errCode = Error::MaxLengthExceeded;
+        return 0;
+      }
+      inputLength += input.size();
+    }
+    // outputs can't hold more than the address space, a saturated sum is enough
+    size_t outputLength = 0;
+    for (const auto& output: outputs) {
+      outputLength += std::min(output.size(), gNoInputLimit - outputLength);
+    }
+    if (outputLength < encodedSize(inputLength)) {
+      errCode = Error::BufferTooSmall;
+      return 0;
+    }
+
+    // whole blocks go straight into segments, a block crossing their boundary is staged
+    SegmentWriter<char> writer(outputs);
+    Encoder encoder;
+    std::array<char, gCharsPerB32Block> stage{};
+    for (auto chunk: inputs) {
+      while (!chunk.empty()) {
+        const std::span<char> free = writer.current();
+        const size_t fitBytes = free.size() / gCharsPerB32Block * gBytesPerB32Block;
+        const size_t taken = std::min(chunk.size(), fitBytes != 0 ? fitBytes : gBytesPerB32Block);
+        if (fitBytes != 0) {
+          writer.advance(encoder.update(chunk.first(taken), free, errCode));
+        } else {
+          writer.write(stage.data(), encoder.update(chunk.first(taken), stage, errCode));
+        }
+        chunk = chunk.subspan(taken);
+      }
+    }
+    writer.write(stage.data(), encoder.finalize(stage, errCode));
+
+    return writer.written();
+  }
+
+  size_t decodeSegments(std::span<const std::string_view> inputs, std::span<const std::span<uint8_t>> outputs,
+                        Error& errCode) {
+    // whole blocks go straight into segments, a block crossing their boundary is staged
+    SegmentWriter<uint8_t> writer(outputs);
+    Decoder decoder;
+    std::array<uint8_t, gBytesPerB32Block> stage{};
+    errCode = Error::NoError;
+    for (auto chunk: inputs) {
+      while (!chunk.empty()) {
+        const std::span<uint8_t> free = writer.current();
+        const size_t fitChars = free.size() / gBytesPerB32Block * gCharsPerB32Block;
+        const size_t taken = std::min(chunk.size(), fitChars != 0 ? fitChars : gCharsPerB32Block);
+        if (fitChars != 0) {
+          writer.advance(decoder.update(chunk.substr(0, taken), free, errCode));
+        } else if (!writer.write(stage.data(), decoder.update(chunk.substr(0, taken), stage, errCode))
+                   && errCode == Error::NoError) {
+          errCode = Error::BufferTooSmall;
+        }
+        if (errCode != Error::NoError) {
+          return writer.written();
+        }
+        chunk = chunk.substr(taken);
+      }
+    }
+
+    if (!writer.write(stage.data(), decoder.finalize(stage, errCode))) {
+      errCode = Error::BufferTooSmall;
+    }
+
+    return writer.written();
+  }
+}  // namespace base32
@@ -0,0 +1,263 @@
+#include <boost/ut.hpp>
+
+#include <algorithm>
+#include <coroutine>
+#include <span>
+#include <string>
+
+#include "base32/async.hpp"
+#include "base32/base32.hpp"
+
+using namespace boost::ut;
+
+constexpr base32::Bytes stringToBytes(std::string_view str) {
+  base32::Bytes result;
+  for (const auto ch: str) {
+    result.push_back(ch);
+  }
+
+  return result;
+}
+
+namespace {
+  /*!
+   * \brief The Ready struct
+   *
+   * Awaitable completing at once with value
+   */
+  struct Ready {
+    bool await_ready() const noexcept {
+      return true;
+    }
+
+    void await_suspend(std::coroutine_handle<> /*handle*/) const noexcept {}
+
+    size_t await_resume() const noexcept {
+      return value;
+    }
+
+    size_t value;
+  };
+
+  /*!
+   * \brief The MemorySource struct
+   *
+   * Serves data in reads of at most readSize elements
+   */
+  template <typename Element>
+  struct MemorySource {
+    Ready read(std::span<Element> buffer) {
+      const size_t count = std::min({buffer.size(), readSize, data.size() - offset});
+      std::copy_n(data.data() + offset, count, buffer.data());
+      offset += count;
+      reads++;
+
+      return {count};
+    }
+
+    std::span<const Element> data;
+    size_t readSize;
+    size_t offset{0};
+    size_t reads{0};
+  };
+
+  /*!
+   * \brief The SlowSink struct
+   *
+   * Suspends every write until resumed by the test, like a socket with full send buffer
+   */
+  template <typename Element>
+  struct SlowSink {
+    struct Awaiter {
+      bool await_ready() const noexcept {
+        return false;
+      }
+
+      void await_suspend(std::coroutine_handle<> handle) {
+        sink.pending = handle;
+      }
+
+      void await_resume() const noexcept {}
+
+      SlowSink& sink;
+    };
+
+    Awaiter write(std::span<const Element> data) {
+      written.insert(written.end(), data.begin(), data.end());
+      writes++;
+
+      return {*this};
+    }
+
+    std::basic_string<Element> written;
+    std::coroutine_handle<> pending;
+    size_t writes{0};
+  };
+
+  /*!
+   * \brief The Detached struct
+   *
+   * Eagerly started coroutine owned by the test
+   */
+  struct Detached {
+    struct promise_type {
+      Detached get_return_object() {
+        return {};
+      }
+
+      std::suspend_never initial_suspend() noexcept {
+        return {};
+      }
+
+      std::suspend_never final_suspend() noexcept {
+        return {};
+      }
+
+      void return_void() {}
+
+      void unhandled_exception() {
+        std::terminate();
+      }
+    };
+  };
+
+  template <typename Source, typename Sink>
+  Detached runEncode(Source& source, Sink& sink, size_t chunkBlocks, base32::Error& result, bool& done) {
+    result = co_await base32::asyncEncode(source, sink, chunkBlocks);
+    done = true;
+  }
+
+  template <typename Source, typename Sink>
+  Detached runDecode(Source& source, Sink& sink, size_t chunkBlocks, base32::Error& result, bool& done) {
+    result = co_await base32::asyncDecode(source, sink, chunkBlocks);
+    done = true;
+  }
+
+  /*!
+   * \brief drain
+   *
+   * Resume writes of sink until the task finishes
+   */
+  template <typename Sink>
+  void drain(Sink& sink, const bool& done) {
+    while (!done && sink.pending) {
+      std::exchange(sink.pending, nullptr).resume();
+    }
+  }
+}  // namespace
+
+suite<"b32_async"> b32_async = [] {
+  test("async_encode_matches_encode") = [] {
+    base32::Error err{};
+    base32::Bytes bytes(10007);
+    for (size_t i = 0; i < bytes.size(); i++) {
+      bytes[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+
+    for (const size_t readSize: {1, 7, 320, 100000}) {
+      MemorySource<uint8_t> source{bytes, readSize};
+      SlowSink<char> sink;
+      base32::Error result = base32::Error::BufferTooSmall;
+      bool done = false;
+      runEncode(source, sink, 64, result, done);
+      drain(sink, done);
+
+      expect(done);
+      expect(result == base32::Error::NoError);
+      expect(sink.written == base32::encode(bytes, err));
+    }
+  };
+
+  test("async_encode_backpressure") = [] {
+    const auto bytes = stringToBytes("foobarfoobarfoobar");
+    MemorySource<uint8_t> source{bytes, 5};
+    SlowSink<char> sink;
+    base32::Error result{};
+    bool done = false;
+    runEncode(source, sink, 1, result, done);
+
+    // nothing is read while a write is pending
+    expect(sink.writes == 1_u && source.reads == 1_u && !done);
+    sink.pending.resume();
+    expect(sink.writes == 2_u && source.reads == 2_u);
+    drain(sink, done);
+    expect(done);
+    expect(sink.written == "MZXW6YTBOJTG633CMFZGM33PMJQXE===");
+  };
+
+  test("async_encode_empty") = [] {
+    MemorySource<uint8_t> source{{}, 1};
+    SlowSink<char> sink;
+    base32::Error result = base32::Error::BufferTooSmall;
+    bool done = false;
+    runEncode(source, sink, base32::gAsyncChunkBlocks, result, done);
+
+    expect(done);
+    expect(result == base32::Error::NoError);
+    expect(sink.writes == 0_u);
+  };
+
+  test("async_encode_zero_chunk_blocks") = [] {
+    const auto bytes = stringToBytes("foobarfoobar");
+    MemorySource<uint8_t> source{bytes, 100};
+    SlowSink<char> sink;
+    base32::Error result = base32::Error::BufferTooSmall;
+    bool done = false;
+    runEncode(source, sink, 0, result, done);
+    drain(sink, done);
+
+    expect(done);
+    expect(result == base32::Error::NoError);
+    expect(sink.written == "MZXW6YTBOJTG633CMFZA====");
+  };
+
+  test("async_decode_matches_decode") = [] {
+    base32::Error err{};
+    base32::Bytes bytes(10007);
+    for (size_t i = 0; i < bytes.size(); i++) {
+      bytes[i] = static_cast<uint8_t>(i * 151 + 3);
+    }
+    const std::string encoded = base32::encode(bytes, err);
+
+    for (const size_t readSize: {1, 9, 512, 100000}) {
+      MemorySource<char> source{encoded, readSize};
+      SlowSink<uint8_t> sink;
+      base32::Error result = base32::Error::BufferTooSmall;
+      bool done = false;
+      runDecode(source, sink, 64, result, done);
+      drain(sink, done);
+
+      expect(done);
+      expect(result == base32::Error::NoError);
+      expect(std::ranges::equal(sink.written, bytes));
+    }
+  };
+
+  test("async_decode_zero_chunk_blocks") = [] {
+    const std::string encoded = "MZXW6YTBOJTG633CMFZA====";
+    MemorySource<char> source{encoded, 100};
+    SlowSink<uint8_t> sink;
+    base32::Error result = base32::Error::BufferTooSmall;
+    bool done = false;
+    runDecode(source, sink, 0, result, done);
+    drain(sink, done);
+
+    expect(done);
+    expect(result == base32::Error::NoError);
+    expect(std::ranges::equal(sink.written, std::string_view("foobarfoobar")));
+  };
+
+  test("async_decode_invalid") = [] {
+    const std::string encoded = "MZXW6YTBOJTG633CMFZGM33P!JQXE===";
+    MemorySource<char> source{encoded, 8};
+    SlowSink<uint8_t> sink;
+    base32::Error result{};
+    bool done = false;
+    runDecode(source, sink, 1, result, done);
+    drain(sink, done);
+
+    expect(done);
+    expect(result == base32::Error::InvalidB32Input);
+    expect(std::ranges::equal(sink.written, std::string_view("foobarfoobarfoo")));
+  };
+};
@@ -0,0 +1,116 @@
+#include <boost/ut.hpp>
+
+#include <string>
+
+#include "base32/base32.hpp"
+#include "base32/checksum.hpp"
+
+using namespace boost::ut;
+
+constexpr base32::Bytes stringToBytes(std::string_view str) {
+  base32::Bytes result;
+  for (const auto ch: str) {
+    result.push_back(ch);
+  }
+
+  return result;
+}
+
+/*!
+ * \brief reference bitwise CRC-32C
+ */
+uint32_t crc32cReference(const base32::Bytes& bytes) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (const uint8_t byte: bytes) {
+    crc ^= byte;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1U) != 0 ? (crc >> 1U) ^ 0x82F63B78 : crc >> 1U;
+    }
+  }
+
+  return ~crc;
+}
+
+suite<"b32_checksum"> b32_checksum = [] {
+  test("crc32c_check_value") = [] {
+    base32::Crc32c crc;
+    crc(stringToBytes("123456789"));
+    expect(crc.value() == 0xE3069283_u);
+
+    expect(base32::Crc32c().value() == 0_u);
+  };
+
+  test("encode_into_hashed_matches_separate_passes") = [] {
+    base32::Error err{};
+    base32::Bytes bytes;
+    for (size_t i = 0; i < 3 * base32::gHashChunkBytes + 7; i++) {
+      bytes.push_back(static_cast<uint8_t>(i * 131 + 7));
+    }
+
+    for (const size_t size: {size_t{0}, size_t{1}, size_t{13}, base32::gHashChunkBytes, bytes.size()}) {
+      const base32::Bytes input(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(size));
+      base32::Crc32c crc;
+      std::string encoded(base32::encodedSize(size), '\0');
+      expect(base32::encodeIntoHashed(input, encoded, err, crc) == encoded.size());
+      expect(err == base32::Error::NoError);
+      expect(encoded == base32::encode(input, err));
+      expect(crc.value() == crc32cReference(input));
+    }
+  };
+
+  test("encode_into_hashed_wraps_lines") = [] {
+    base32::Error err{};
+    base32::Bytes bytes;
+    for (size_t i = 0; i < 3 * base32::gHashChunkBytes + 7; i++) {
+      bytes.push_back(static_cast<uint8_t>(i * 131 + 7));
+    }
+
+    for (const size_t lineWidth: {size_t{1}, size_t{64}, size_t{76}, size_t{20000}}) {
+      const base32::EncodeOptions options{.lineWidth = lineWidth, .lineSeparator = "\r\n"};
+      base32::Crc32c crc;
+      std::string encoded(base32::encodedSize(bytes.size(), options), '\0');
+      expect(base32::encodeIntoHashed(bytes, encoded, err, crc, options) == encoded.size());
+      expect(err == base32::Error::NoError);
+      expect(encoded == base32::encode(bytes, err, options));
+      expect(crc.value() == crc32cReference(bytes));
+    }
+  };
+
+  test("encoder_update_hashed") = [] {
+    base32::Error err{};
+    base32::Bytes bytes;
+    for (size_t i = 0; i < 2 * base32::gHashChunkBytes + 3; i++) {
+      bytes.push_back(static_cast<uint8_t>(i * 29 + 3));
+    }
+
+    base32::Encoder encoder;
+    base32::Crc32c crc;
+    std::string encoded;
+    for (size_t pos = 0; pos < bytes.size(); pos += 4099) {
+      const auto chunk = std::span(bytes).subspan(pos, std::min<size_t>(4099, bytes.size() - pos));
+      std::string out(encoder.updateSize(chunk.size()), '\0');
+      out.resize(encoder.update(chunk, out, err, crc));
+      encoded += out;
+    }
+    std::string out(encoder.finalizeSize(), '\0');
+    out.resize(encoder.finalize(out, err));
+    encoded += out;
+
+    expect(encoded == base32::encode(bytes, err));
+    expect(crc.value() == crc32cReference(bytes));
+  };
+
+  test("hasher_untouched_on_error") = [] {
+    base32::Error err{};
+    base32::Crc32c crc;
+    std::string encoded(7, '\0');
+    base32::encodeIntoHashed(stringToBytes("foobar"), encoded, err, crc);
+    expect(err == base32::Error::BufferTooSmall);
+    expect(crc.value() == 0_u);
+
+    std::string large(16, '\0');
+    expect(base32::encodeIntoHashed(stringToBytes("foobar"), large, err, crc, {.maxInputLength = 5}) == 0_u);
+    expect(err == base32::Error::MaxLengthExceeded);
+    expect(crc.value() == 0_u);
+  };
+};
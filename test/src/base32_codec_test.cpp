@@ -0,0 +1,239 @@
+#include <boost/ut.hpp>
+
+#include "base32/codec.hpp"
+
+using namespace boost::ut;
+
+constexpr base32::Bytes stringToBytes(std::string_view str) {
+  base32::Bytes result;
+  for (const auto ch: str) {
+    result.push_back(ch);
+  }
+
+  return result;
+}
+
+/*!
+ * \brief translate RFC 4648 encoded string into other alphabet, padding is kept or dropped
+ */
+std::string translate(std::string_view rfcEncoded, std::string_view alphabet, base32::Padding padding) {
+  std::string result;
+  for (const char chr: rfcEncoded) {
+    if (chr == '=') {
+      if (padding == base32::Padding::Enabled) {
+        result.push_back(chr);
+      }
+    } else {
+      result.push_back(alphabet[base32::Rfc4648Alphabet::gChars.find(chr)]);
+    }
+  }
+
+  return result;
+}
+
+template <typename Codec, typename Alphabet, base32::Padding padding>
+void checkCodecMatchesRfc(const base32::Bytes& bytes) {
+  base32::Error err{};
+  const auto expected = translate(base32::encode(bytes, err), Alphabet::gChars, padding);
+
+  const auto encoded = Codec::encode(bytes, err);
+  expect(err == base32::Error::NoError);
+  expect(encoded == expected);
+  expect(encoded.size() == Codec::encodedSize(bytes.size()));
+
+  const auto decoded = Codec::decode(encoded, err);
+  expect(err == base32::Error::NoError);
+  expect(decoded == bytes);
+}
+
+static_assert(base32::encodedSize(0, base32::Padding::Disabled) == 0);
+static_assert(base32::encodedSize(1, base32::Padding::Disabled) == 2);
+static_assert(base32::encodedSize(4, base32::Padding::Disabled) == 7);
+static_assert(base32::encodedSize(5, base32::Padding::Disabled) == 8);
+static_assert(base32::encodedSize(6, base32::Padding::Disabled) == 10);
+
+// lengths of multi GB inputs don't overflow
+constexpr size_t gMaxEncodable = base32::gNoInputLimit / 8 * 5;
+static_assert(base32::encodedSize(gMaxEncodable) == gMaxEncodable / 5 * 8);
+static_assert(base32::encodedSize(gMaxEncodable, base32::Padding::Disabled) == gMaxEncodable / 5 * 8);
+static_assert(base32::maxDecodedSize(base32::gNoInputLimit) == base32::gNoInputLimit / 8 * 5 + 4);
+
+static_assert(base32::Base32HexCodec::decodeArray<"CPNMUOJ1E8======">() == std::array<uint8_t, 6>{'f', 'o', 'o', 'b', 'a', 'r'});
+static_assert(std::string_view(base32::ZBase32Codec::encodeArray(std::array<uint8_t, 1>{0}).data(), 2) == "yy");
+
+suite<"b32_codec"> b32_codec = [] {
+  test("base32hex_rfc4648_vectors") = [] {
+    base32::Error err{};
+    const std::array<std::pair<std::string_view, std::string_view>, 7> vectors{{
+      {"", ""},
+      {"f", "CO======"},
+      {"fo", "CPNG===="},
+      {"foo", "CPNMU==="},
+      {"foob", "CPNMUOG="},
+      {"fooba", "CPNMUOJ1"},
+      {"foobar", "CPNMUOJ1E8======"},
+    }};
+
+    for (const auto& [plain, encoded]: vectors) {
+      expect(base32::Base32HexCodec::encode(stringToBytes(plain), err) == encoded);
+      expect(base32::Base32HexCodec::decode(encoded, err) == stringToBytes(plain));
+      expect(base32::Base32HexCodec::decodedEquals(encoded, stringToBytes(plain)));
+      expect(err == base32::Error::NoError);
+    }
+  };
+
+  test("unpadded_input_is_accepted") = [] {
+    base32::Error err{};
+
+    expect(base32::Base32HexCodec::decode("CPNMUOJ1E8", err) == stringToBytes("foobar"));
+    expect(err == base32::Error::NoError);
+    expect(base32::CrockfordCodec::encode(stringToBytes("foobar"), err).size() == 10);
+  };
+
+  test("out_of_alphabet_chars") = [] {
+    base32::Error err{};
+
+    // 'W' is not a base32hex char, 'U' is not a Crockford char, uppercase is not z-base-32
+    base32::Base32HexCodec::decode("CPNMUOJW", err);
+    expect(err == base32::Error::InvalidB32Input);
+    base32::CrockfordCodec::decode("CPNMUOJU", err);
+    expect(err == base32::Error::InvalidB32Input);
+    base32::ZBase32Codec::decode("YBNDRFG8", err);
+    expect(err == base32::Error::InvalidB32Input);
+  };
+
+  test("alphabets_match_rfc4648_on_all_backends") = [] {
+    base32::Bytes bytes;
+    for (int i = 0; i < 1029; i++) {
+      bytes.push_back(static_cast<uint8_t>(i * 131 + 7));
+    }
+
+    for (const auto backend: {base32::Backend::Scalar, base32::Backend::Sse41, base32::Backend::Avx2,
+                              base32::Backend::Avx512, base32::Backend::Neon}) {
+      if (!base32::selectBackend(backend)) {
+        continue;
+      }
+
+      for (const size_t size: {0, 1, 4, 5, 17, 160, 1029}) {
+        const base32::Bytes input(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(size));
+        checkCodecMatchesRfc<base32::Base32HexCodec, base32::Base32HexAlphabet, base32::Padding::Enabled>(input);
+        checkCodecMatchesRfc<base32::CrockfordCodec, base32::CrockfordAlphabet, base32::Padding::Disabled>(input);
+        checkCodecMatchesRfc<base32::ZBase32Codec, base32::ZBase32Alphabet, base32::Padding::Disabled>(input);
+      }
+    }
+    base32::resetBackend();
+  };
+
+  test("crockford_confusables") = [] {
+    base32::Error err{};
+    const auto expected = base32::CrockfordCodec::decode("01AB-1CDE", err, {.mapConfusables = true});
+    expect(err == base32::Error::NoError);
+
+    base32::CrockfordCodec::decode("OIAB-LCDE", err);
+    expect(err == base32::Error::InvalidB32Input);
+    expect(base32::CrockfordCodec::decode("OIAB-LCDE", err, {.mapConfusables = true}) == expected);
+    expect(err == base32::Error::NoError);
+    expect(base32::CrockfordCodec::decode("oiab-lcde", err, {.ignoreCase = true, .mapConfusables = true}) == expected);
+    expect(err == base32::Error::NoError);
+  };
+
+  test("zbase32_ignores_confusables") = [] {
+    base32::Error err{};
+    const auto expected = base32::ZBase32Codec::decode("ybnd1fg8", err);
+    expect(err == base32::Error::NoError);
+    expect(base32::ZBase32Codec::decode("ybnd1fg8", err, {.mapConfusables = true}) == expected);
+    expect(err == base32::Error::NoError);
+
+    // 'i' and 'o' are letters of z-base-32, 'I' is not its '1' and hyphens are not skipped
+    base32::ZBase32Codec::decode("ybndIfg8", err, {.mapConfusables = true});
+    expect(err == base32::Error::InvalidB32Input);
+    base32::ZBase32Codec::decode("ybnd-1fg8", err, {.mapConfusables = true});
+    expect(err == base32::Error::InvalidB32Input);
+    expect(base32::ZBase32Codec::decode("ybndIfg8", err, {.ignoreCase = true, .mapConfusables = true})
+           == base32::ZBase32Codec::decode("ybndifg8", err));
+    expect(err == base32::Error::NoError);
+    base32::Base32HexCodec::decode("CPNM-UOJ1", err, {.mapConfusables = true});
+    expect(err == base32::Error::InvalidB32Input);
+  };
+
+  test("fixed_width") = [] {
+    std::array<uint8_t, 20> digest{};
+    for (size_t i = 0; i < digest.size(); i++) {
+      digest[i] = static_cast<uint8_t>(i * 151 + 7);
+    }
+    const auto hex = base32::Base32HexCodec::encode(digest);
+    base32::Error err{};
+    expect(std::string_view(hex.data(), hex.size()) == base32::Base32HexCodec::encode(digest, err));
+    expect(base32::Base32HexCodec::decode<20>(std::string_view(hex.data(), hex.size())).value() == digest);
+
+    const std::array<uint8_t, 6> foobar{'f', 'o', 'o', 'b', 'a', 'r'};
+    using UnpaddedCodec = base32::BasicCodec<base32::Rfc4648Alphabet, base32::Padding::Disabled>;
+    const auto unpadded = UnpaddedCodec::encode(foobar);
+    expect(std::string_view(unpadded.data(), unpadded.size()) == "MZXW6YTBOI");
+    expect(UnpaddedCodec::decode<6>("MZXW6YTBOI").value() == foobar);
+    expect(!UnpaddedCodec::decode<5>("MZXW6YTBOI").has_value());
+  };
+
+  test("runtime_codec_reuses_storage") = [] {
+    base32::Error err{};
+    base32::Codec codec;
+    expect(codec.encode(stringToBytes("foobar"), err) == "MZXW6YTBOI======");
+    expect(std::ranges::equal(codec.decode("MZXW6YTBOI", err), std::string_view("foobar")));
+    expect(err == base32::Error::NoError);
+
+    base32::Bytes bytes(4096);
+    for (size_t i = 0; i < bytes.size(); i++) {
+      bytes[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+    const std::string encoded(codec.encode(bytes, err));
+    const char* const storage = codec.encode(stringToBytes("fo"), err).data();
+    expect(codec.encode(bytes, err).data() == storage);
+    expect(std::ranges::equal(codec.decode(encoded, err), bytes));
+    const uint8_t* const decodedStorage = codec.decode(encoded, err).data();
+    expect(codec.decode("MZXW6===", err).data() == decodedStorage);
+
+    codec.decode("MZXW6YTBO!======", err);
+    expect(err == base32::Error::InvalidB32Input);
+  };
+
+  test("runtime_codec_settings") = [] {
+    base32::Error err{};
+    base32::Codec crockford(base32::CrockfordAlphabet{}, {.padding = base32::Padding::Disabled},
+                            {.ignoreCase = true});
+    expect(crockford.encode(stringToBytes("foobar"), err) == base32::CrockfordCodec::encode(stringToBytes("foobar"), err));
+    expect(std::ranges::equal(crockford.decode("csqpyrk1e8", err), std::string_view("foobar")));
+    expect(err == base32::Error::NoError);
+
+    base32::Codec limited(base32::EncodeOptions{.maxInputLength = 4}, base32::DecodeOptions{.maxInputLength = 8});
+    expect(limited.encode(stringToBytes("foobar"), err).empty());
+    expect(err == base32::Error::MaxLengthExceeded);
+    expect(limited.decode("MZXW6YTBOI", err).empty());
+    expect(err == base32::Error::MaxLengthExceeded);
+    expect(base32::Base32HexCodec::decode("CPNMUOJ1E8", err, {.maxInputLength = 8}).empty());
+    expect(err == base32::Error::MaxLengthExceeded);
+
+    // separators of 1 character lines don't fit size_t, encode rejects the saturated length before allocating
+    const base32::EncodeOptions wrapped{.maxInputLength = base32::gNoInputLimit, .lineWidth = 1};
+    expect(base32::Base32HexCodec::encodedSize(base32::gNoInputLimit / 16 * 5, wrapped) == base32::gNoInputLimit);
+    expect(base32::CrockfordCodec::encodedSize(base32::gNoInputLimit / 16 * 5, wrapped) == base32::gNoInputLimit);
+  };
+
+  test("runtime_codec_owns_line_separator") = [] {
+    base32::Error err{};
+    std::string separator(40, '-');
+    base32::Codec codec(base32::EncodeOptions{.lineWidth = 8, .lineSeparator = separator});
+    separator.assign(40, '#');
+
+    const std::string expected = "MZXW6YTB" + std::string(40, '-') + "OI======";
+    expect(codec.encode(stringToBytes("foobar"), err) == expected);
+    expect(codec.encodeOptions().lineSeparator == std::string(40, '-'));
+
+    base32::Codec moved(std::move(codec));
+    const base32::Codec copy(moved);
+    base32::Codec assigned;
+    assigned = copy;
+    moved = base32::Codec();
+    expect(assigned.encode(stringToBytes("foobar"), err) == expected);
+    expect(err == base32::Error::NoError);
+  };
+};
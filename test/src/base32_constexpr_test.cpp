@@ -0,0 +1,63 @@
+#include <boost/ut.hpp>
+
+#include "base32/base32.hpp"
+
+using namespace boost::ut;
+using namespace base32::literals;
+
+template <size_t N>
+constexpr std::array<uint8_t, N - 1> literalToBytes(const char (&str)[N]) {
+  std::array<uint8_t, N - 1> result{};
+  for (size_t i = 0; i + 1 < N; i++) {
+    result[i] = static_cast<uint8_t>(str[i]);
+  }
+
+  return result;
+}
+
+template <size_t N>
+constexpr bool charsEqual(const std::array<char, N>& chars, std::string_view expected) {
+  return std::string_view(chars.data(), chars.size()) == expected;
+}
+
+// rfc4648 test vectors checked at compile time
+static_assert(charsEqual(base32::encodeArray(literalToBytes("")), ""));
+static_assert(charsEqual(base32::encodeArray(literalToBytes("f")), "MY======"));
+static_assert(charsEqual(base32::encodeArray(literalToBytes("fo")), "MZXQ===="));
+static_assert(charsEqual(base32::encodeArray(literalToBytes("foo")), "MZXW6==="));
+static_assert(charsEqual(base32::encodeArray(literalToBytes("foob")), "MZXW6YQ="));
+static_assert(charsEqual(base32::encodeArray(literalToBytes("fooba")), "MZXW6YTB"));
+static_assert(charsEqual(base32::encodeArray(literalToBytes("foobar")), "MZXW6YTBOI======"));
+
+static_assert(""_b32.empty());
+static_assert("MY======"_b32 == literalToBytes("f"));
+static_assert("MZXQ===="_b32 == literalToBytes("fo"));
+static_assert("MZXW6==="_b32 == literalToBytes("foo"));
+static_assert("MZXW6YQ="_b32 == literalToBytes("foob"));
+static_assert("MZXW6YTB"_b32 == literalToBytes("fooba"));
+static_assert("MZXW6YTBOI======"_b32 == literalToBytes("foobar"));
+static_assert("MZXW6YTBOI"_b32 == literalToBytes("foobar"));
+static_assert("MZXW 6YTB OI== ===="_b32 == literalToBytes("foobar"));
+
+suite<"b32_constexpr"> b32_constexpr = [] {
+  test("encode_array_matches_runtime") = [] {
+    base32::Error err{};
+    constexpr std::array<uint8_t, 11> bytes{0x00, 0x01, 0x7F, 0x80, 0xFF, 0x10, 0x20, 0x30, 0x40, 0xAB, 0xCD};
+    constexpr auto encoded = base32::encodeArray(bytes);
+
+    const auto expected = base32::encode(base32::Bytes(bytes.begin(), bytes.end()), err);
+
+    expect(err == base32::Error::NoError);
+    expect(std::string_view(encoded.data(), encoded.size()) == expected);
+  };
+
+  test("decode_array_matches_runtime") = [] {
+    base32::Error err{};
+    constexpr auto decoded = base32::decodeArray<"LLFTSZYMUGKHEDQBAAACAZAMUFKKVFLS">();
+
+    const auto expected = base32::decode("LLFTSZYMUGKHEDQBAAACAZAMUFKKVFLS", err);
+
+    expect(err == base32::Error::NoError);
+    expect(base32::Bytes(decoded.begin(), decoded.end()) == expected);
+  };
+};
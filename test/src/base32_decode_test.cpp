@@ -1,7 +1,10 @@
+#include <algorithm>
+#include <cctype>
 #include <cstdio>
 
 #include <boost/ut.hpp>
 #include <cstring>
+#include <memory_resource>
 
 #include "base32/base32.hpp"
 
@@ -82,6 +85,35 @@ suite<"decode"> b32_decode = [] {
     expect(err == base32::Error::MaxLengthExceeded);
   };
 
+  test("input_limit_option") = [] {
+    base32::Error err{};
+    const std::string k(128 * 1024 * 1024, 'A');
+
+    expect(base32::decode(k, err, {.maxInputLength = base32::gNoInputLimit}).size() == base32::maxDecodedSize(k.size()));
+    expect(err == base32::Error::NoError);
+
+    expect(base32::decode("MZXW6YTBOI======", err, {.maxInputLength = 8}).empty());
+    expect(err == base32::Error::MaxLengthExceeded);
+    const auto result = base32::decode("MZXW6YTBOI======", {.maxInputLength = 8});
+    expect(!result.has_value() && result.error().offset == 8);
+  };
+
+  test("max_input_round_trip") = [] {
+    // a configured limit may be too big to allocate
+    if (base32::gDefaultMaxEncodeInputLen > 256ULL * 1024 * 1024) {
+      return;
+    }
+
+    base32::Error err{};
+    const base32::Bytes bytes(base32::gDefaultMaxEncodeInputLen, 'f');
+    const auto encoded = base32::encode(bytes, err);
+    expect(err == base32::Error::NoError);
+    expect(encoded.size() == base32::gDefaultMaxDecodeInputLen);
+
+    expect(base32::decode(encoded, err) == bytes);
+    expect(err == base32::Error::NoError);
+  };
+
   test("input_whitespaces") = [] {
     base32::Error err{};
     const char *k = "MZ XW 6Y TB";
@@ -131,5 +163,448 @@ suite<"decode"> b32_decode = [] {
       expect(binary[i] == 0_i);
     }
   };
-};
 
+  test("decode_into_rfc4648") = [] {
+    base32::Error err{};
+    const char *k[]
+        = {"", "MY======", "MZXQ====", "MZXW6===", "MZXW6YQ=", "MZXW6YTB", "MZXW6YTBOI======"};
+    const char *k_dec[] = {"", "f", "fo", "foo", "foob", "fooba", "foobar"};
+
+    for (int i = 0; i < 7; i++) {
+      base32::Bytes buffer(base32::maxDecodedSize(std::strlen(k[i])));
+      const size_t written = base32::decodeInto(k[i], buffer, err);
+      expect(err == base32::Error::NoError);
+      buffer.resize(written);
+      expect(buffer == stringToBytes(k_dec[i]));
+    }
+  };
+
+  test("decode_into_buffer_too_small") = [] {
+    base32::Error err{};
+    base32::Bytes buffer(5);
+
+    const size_t written = base32::decodeInto("MZXW6YTBOI======", buffer, err);
+
+    expect(written == 0_u);
+    expect(err == base32::Error::BufferTooSmall);
+  };
+
+  test("input_whitespaces_between_blocks") = [] {
+    base32::Error err{};
+    const char *k = "IFCEMRZU GEZSDQVD EQSS MJRIFAXT6 XWDU7B2SKS3LURSS LJOFR6DYPRL";
+    const auto expected = stringToBytes("ADFG413!£$%&&((/?^çé*[]#)-.,|<>+");
+
+    const auto dk = base32::decode(k, err);
+
+    expect(err == base32::Error::NoError);
+    expect(dk == expected);
+  };
+
+  test("input_whitespaces_around_padding") = [] {
+    base32::Error err{};
+
+    const auto dk = base32::decode("MZXW6YTB MY== ==== ", err);
+
+    expect(err == base32::Error::NoError);
+    expect(dk == stringToBytes("foobaf"));
+  };
+
+  test("invalid_char_after_full_blocks") = [] {
+    base32::Error err{};
+
+    base32::decode("MZXW6YTBMZXW6YTBMZ1W6YTB", err);
+    expect(err == base32::Error::InvalidB32Input);
+
+    base32::decode("MZXW6YTBMZXW6YT=MZXW6YTB", err);
+    expect(err == base32::Error::InvalidB32Input);
+  };
+
+  test("backends_match_scalar") = [] {
+    base32::Error err{};
+    base32::Bytes bytes;
+    for (int i = 0; i < 400; i++) {
+      bytes.push_back(static_cast<uint8_t>(i * 151 + 7));
+    }
+    expect(base32::selectBackend(base32::Backend::Scalar));
+    const std::string encoded = base32::encode(bytes, err);
+
+    for (const auto backend: {base32::Backend::Scalar, base32::Backend::Sse41, base32::Backend::Avx2,
+                              base32::Backend::Avx512, base32::Backend::Neon}) {
+      if (!base32::selectBackend(backend)) {
+        continue;
+      }
+      expect(base32::decode(encoded, err) == bytes);
+      expect(err == base32::Error::NoError);
+
+      for (size_t pos = 0; pos < encoded.size(); pos += 13) {
+        std::string corrupted = encoded;
+        corrupted[pos] = '1';
+        base32::decode(corrupted, err);
+        expect(err == base32::Error::InvalidB32Input);
+
+        const std::string spaced = encoded.substr(0, pos) + ' ' + encoded.substr(pos);
+        expect(base32::decode(spaced, err) == bytes);
+        expect(err == base32::Error::NoError);
+      }
+    }
+    base32::resetBackend();
+  };
+
+  test("lenient_options") = [] {
+    base32::Error err{};
+
+    base32::decode("mzxw6ytboi======", err);
+    expect(err == base32::Error::InvalidB32Input);
+    expect(base32::decode("mzxw6YTBoi======", err, {.ignoreCase = true}) == stringToBytes("foobar"));
+    expect(err == base32::Error::NoError);
+
+    base32::decode("MZXW6YTB\r\nOI======\n", err);
+    expect(err == base32::Error::InvalidB32Input);
+    expect(base32::decode("MZXW\t6YTB\r\nOI======\n", err, {.skipAllWhitespaces = true}) == stringToBytes("foobar"));
+    expect(err == base32::Error::NoError);
+  };
+
+  test("require_padding") = [] {
+    base32::Error err{};
+    const base32::DecodeOptions options{.requirePadding = true};
+
+    expect(base32::decode("MZXW6YTBOI", err) == stringToBytes("foobar"));
+    expect(err == base32::Error::NoError);
+    base32::decode("MZXW6YTBOI", err, options);
+    expect(err == base32::Error::InvalidB32Input);
+    base32::decode("MZXW6YTBOI===", err, options);
+    expect(err == base32::Error::InvalidB32Input);
+    base32::decode("MZXW6YTBOIA=====", err, options);
+    expect(err == base32::Error::InvalidB32Input);
+    base32::decode("MZXW6YTB========", err, options);
+    expect(err == base32::Error::InvalidB32Input);
+
+    expect(base32::decode("MZXW 6YTB OI== ====", err, options) == stringToBytes("foobar"));
+    expect(err == base32::Error::NoError);
+    expect(base32::decode("MZXW6YTB", err, options) == stringToBytes("fooba"));
+    expect(err == base32::Error::NoError);
+    expect(base32::decode("", err, options).empty());
+    expect(err == base32::Error::NoError);
+  };
+
+  test("lenient_backends_match_scalar") = [] {
+    base32::Error err{};
+    base32::Bytes bytes;
+    for (int i = 0; i < 400; i++) {
+      bytes.push_back(static_cast<uint8_t>(i * 151 + 7));
+    }
+    std::string encoded = base32::encode(bytes, err);
+    for (size_t pos = 0; pos < encoded.size(); pos += 3) {
+      encoded[pos] = static_cast<char>(std::tolower(encoded[pos]));
+    }
+    const std::string wrapped = encoded.substr(0, 100) + "\n" + encoded.substr(100, 200) + "\r\n" + encoded.substr(300);
+    const base32::DecodeOptions options{.ignoreCase = true, .skipAllWhitespaces = true};
+
+    for (const auto backend: {base32::Backend::Scalar, base32::Backend::Sse41, base32::Backend::Avx2,
+                              base32::Backend::Avx512, base32::Backend::Neon}) {
+      if (!base32::selectBackend(backend)) {
+        continue;
+      }
+      expect(base32::decode(encoded, err, options) == bytes);
+      expect(err == base32::Error::NoError);
+      expect(base32::decode(wrapped, err, options) == bytes);
+      expect(err == base32::Error::NoError);
+    }
+    base32::resetBackend();
+  };
+
+  test("validate_and_decoded_size_match_decode") = [] {
+    base32::Error err{};
+    base32::Bytes bytes;
+    for (int i = 0; i < 203; i++) {
+      bytes.push_back(static_cast<uint8_t>(i * 151 + 7));
+    }
+    const std::string encoded = base32::encode(bytes, err);
+
+    std::vector<std::string> inputs{"", " ", "MY======", "MY== ", "MZXW6YTBOI", "MY=A====", "MZXW6YTBOI===="};
+    for (size_t pos = 0; pos < encoded.size(); pos += 11) {
+      for (const char chr: {' ', '\n', '1', '=', '\xA0', '\x80'}) {
+        inputs.push_back(encoded.substr(0, pos) + chr + encoded.substr(pos));
+      }
+      inputs.push_back(encoded.substr(0, pos));
+    }
+
+    for (const auto backend: {base32::Backend::Scalar, base32::Backend::Sse41, base32::Backend::Avx2,
+                              base32::Backend::Avx512, base32::Backend::Neon}) {
+      if (!base32::selectBackend(backend)) {
+        continue;
+      }
+      for (const auto& input: inputs) {
+        for (const bool requirePadding: {false, true}) {
+          const base32::DecodeOptions options{.skipAllWhitespaces = true, .requirePadding = requirePadding};
+          const auto decoded = base32::decode(input, err, options);
+          const base32::Error decodeError = err;
+
+          expect(base32::validate(input, options) == decodeError);
+          const size_t size = base32::decodedSize(input, err, options);
+          expect(err == decodeError);
+          expect(size == (decodeError == base32::Error::NoError ? decoded.size() : 0));
+        }
+      }
+    }
+    base32::resetBackend();
+  };
+
+  test("decoded_equals_matches_decode") = [] {
+    base32::Error err{};
+    base32::Bytes bytes;
+    for (int i = 0; i < 43; i++) {
+      bytes.push_back(static_cast<uint8_t>(i * 151 + 7));
+    }
+    const std::string encoded = base32::encode(bytes, err);
+
+    std::vector<std::string> inputs{"", " ", "MY======", "MY== ", "MZXW6YTBOI", "MY=A====", "MZXW6YTBOI===="};
+    for (size_t pos = 0; pos < encoded.size(); pos += 3) {
+      for (const char chr: {' ', '\n', '1', '='}) {
+        inputs.push_back(encoded.substr(0, pos) + chr + encoded.substr(pos));
+      }
+      inputs.push_back(encoded.substr(0, pos));
+    }
+
+    for (const auto& input: inputs) {
+      for (const bool requirePadding: {false, true}) {
+        const base32::DecodeOptions options{.skipAllWhitespaces = true, .requirePadding = requirePadding};
+        auto decoded = base32::decode(input, err, options);
+        const bool valid = err == base32::Error::NoError;
+
+        expect(base32::decodedEquals(input, decoded, options) == valid);
+        if (!decoded.empty()) {
+          decoded.back() ^= 1;
+          expect(!base32::decodedEquals(input, decoded, options));
+          decoded.pop_back();
+          expect(!base32::decodedEquals(input, decoded, options));
+        }
+        decoded.push_back(0);
+        expect(!base32::decodedEquals(input, decoded, options));
+      }
+    }
+
+    expect(base32::decodedEquals("mzxw6ytboi", stringToBytes("foobar"), {.ignoreCase = true}));
+    expect(!base32::decodedEquals("mzxw6ytboi", stringToBytes("foobar")));
+  };
+
+  test("expected_error_offset") = [] {
+    expect(base32::decode("MZXW6YTBOI======").value() == stringToBytes("foobar"));
+
+    const auto invalid = base32::decode("MZXW6YT!");
+    expect(!invalid.has_value());
+    expect(invalid.error().error == base32::Error::InvalidB32Input);
+    expect(invalid.error().offset == 7_u);
+
+    expect(base32::decode("MZ XW!").error().offset == 5_u);
+    expect(base32::decode("MY=A====").error().offset == 2_u);
+    expect(base32::decode("MZXW6YTBOI", {.requirePadding = true}).error().offset == 10_u);
+  };
+
+  test("expected_error_offset_on_all_backends") = [] {
+    base32::Error err{};
+    base32::Bytes bytes;
+    for (int i = 0; i < 400; i++) {
+      bytes.push_back(static_cast<uint8_t>(i * 151 + 7));
+    }
+    const std::string encoded = base32::encode(bytes, err);
+
+    for (const auto backend: {base32::Backend::Scalar, base32::Backend::Sse41, base32::Backend::Avx2,
+                              base32::Backend::Avx512, base32::Backend::Neon}) {
+      if (!base32::selectBackend(backend)) {
+        continue;
+      }
+      expect(base32::decode(encoded).value() == bytes);
+
+      for (size_t pos = 0; pos < encoded.size() - 1; pos += 7) {
+        std::string corrupted = encoded;
+        corrupted[pos] = static_cast<char>(0xC3);
+        const auto decoded = base32::decode(corrupted);
+        expect(!decoded.has_value());
+        expect(decoded.error().error == base32::Error::InvalidB32Input);
+        expect(decoded.error().offset == pos);
+      }
+    }
+    base32::resetBackend();
+  };
+
+  test("decode_into_pmr_vector") = [] {
+    std::array<std::byte, 1024> buffer{};
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    const auto decoded = base32::decode("MZXW6YTBOI======", std::pmr::vector<uint8_t>(&arena));
+    expect(decoded.has_value());
+    expect(std::ranges::equal(*decoded, stringToBytes("foobar")));
+    expect(decoded->get_allocator().resource() == &arena);
+
+    const auto invalid = base32::decode("MZXW6YT!", std::pmr::string(&arena));
+    expect(!invalid.has_value());
+    expect(invalid.error().offset == 7_u);
+  };
+
+  test("decode_into_container_rejects_before_resize") = [] {
+    // any allocation of the container throws bad_alloc
+    const auto decoded = base32::decode("MZXW6YTBOI======", std::pmr::vector<uint8_t>(std::pmr::null_memory_resource()),
+                                        {.maxInputLength = 8});
+    expect(!decoded.has_value());
+    expect(decoded.error().error == base32::Error::MaxLengthExceeded);
+    expect(decoded.error().offset == 8_u);
+  };
+
+  test("parallel_matches_sequential") = [] {
+    base32::Error err{};
+    base32::Bytes bytes(3 * 1024 * 1024 + 3);
+    for (size_t i = 0; i < bytes.size(); i++) {
+      bytes[i] = static_cast<uint8_t>(i * 131 + i / 7);
+    }
+    std::string encoded = base32::encode(bytes, err);
+    const base32::DecodeOptions options{.threads = 4, .parallelThreshold = 0};
+
+    expect(base32::decode(encoded, err, options) == bytes);
+    expect(err == base32::Error::NoError);
+
+    base32::DecodeOptions paddingOptions = options;
+    paddingOptions.requirePadding = true;
+    expect(base32::decode(encoded, err, paddingOptions) == bytes);
+    expect(err == base32::Error::NoError);
+    base32::decode(std::string_view(encoded).substr(0, encoded.size() - 1), err, paddingOptions);
+    expect(err == base32::Error::InvalidB32Input);
+
+    encoded[encoded.size() / 3] = ' ';
+    encoded[encoded.size() / 2] = ' ';
+    encoded[encoded.size() / 2 + 1] = ' ';
+    const auto sequential = base32::decode(encoded, err);
+    expect(base32::decode(encoded, err, options) == sequential);
+
+    encoded[encoded.size() / 2] = '!';
+    base32::decode(encoded, err, options);
+    expect(err == base32::Error::InvalidB32Input);
+  };
+
+  test("parallel_wrapped_matches_sequential") = [] {
+    base32::Error err{};
+    base32::Bytes bytes(3 * 1024 * 1024 + 2);
+    for (size_t i = 0; i < bytes.size(); i++) {
+      bytes[i] = static_cast<uint8_t>(i * 151 + i / 11);
+    }
+    const base32::DecodeOptions sequentialOptions{.skipAllWhitespaces = true,
+                                                  .requirePadding = true,
+                                                  .maxInputLength = base32::gNoInputLimit};
+    base32::DecodeOptions options = sequentialOptions;
+    options.threads = 4;
+    options.parallelThreshold = 0;
+
+    // line widths not dividing 8 move block boundaries away from slice boundaries
+    for (const size_t lineWidth: {64, 76, 77}) {
+      std::string encoded = base32::encode(bytes, err, {.maxInputLength = base32::gNoInputLimit, .lineWidth = lineWidth});
+      expect(base32::decode(encoded, err, options) == bytes);
+      expect(err == base32::Error::NoError);
+
+      // a slice of whitespaces only, then exact offset of an invalid character
+      encoded.insert(encoded.size() / 4, 2 * 1024 * 1024, ' ');
+      const auto sequential = base32::decode(encoded, err, sequentialOptions);
+      expect(base32::decode(encoded, err, options) == sequential);
+      expect(err == base32::Error::NoError);
+      encoded[encoded.size() / 8] = '!';
+      const auto invalid = base32::decode(encoded, options);
+      expect(!invalid.has_value() && invalid.error().offset == encoded.size() / 8);
+    }
+  };
+
+  test("decode_in_place") = [] {
+    base32::Error err{};
+    base32::Bytes bytes(64 * 1024 + 3);
+    for (size_t i = 0; i < bytes.size(); i++) {
+      bytes[i] = static_cast<uint8_t>(i * 131 + i / 7);
+    }
+    std::string encoded = base32::encode(bytes, err);
+    const base32::DecodeOptions options{.threads = 4, .parallelThreshold = 0};
+    const auto decoded = base32::decodeInPlace(encoded, err, options);
+    expect(err == base32::Error::NoError);
+    expect(std::ranges::equal(decoded, bytes));
+    expect(static_cast<const void*>(decoded.data()) == encoded.data());
+
+    encoded = base32::encode(bytes, err);
+    encoded[100] = ' ';
+    encoded[encoded.size() / 2] = ' ';
+    const auto expected = base32::decode(encoded, err);
+    expect(std::ranges::equal(base32::decodeInPlace(encoded, err), expected));
+    expect(err == base32::Error::NoError);
+
+    std::string foobar = "MZXW6YTBOI======";
+    expect(std::ranges::equal(base32::decodeInPlace(foobar, err), std::string_view("foobar")));
+
+    std::string invalid = "MZXW6YTBO!======";
+    base32::decodeInPlace(invalid, err);
+    expect(err == base32::Error::InvalidB32Input);
+  };
+
+  test("decode_batch") = [] {
+    base32::Error err{};
+    const std::string_view inputs[] = {"MY======", "", "MZXW6YTB", "MZXW6YTBOI======"};
+    base32::Bytes arena(32);
+    size_t lengths[4]{};
+
+    const size_t written = base32::decodeBatch(inputs, arena, lengths, err);
+
+    expect(err == base32::Error::NoError);
+    arena.resize(written);
+    expect(arena == stringToBytes("ffoobafoobar"));
+    expect(lengths[0] == 1_u && lengths[1] == 0_u && lengths[2] == 5_u && lengths[3] == 6_u);
+  };
+
+  test("decode_batch_invalid_item") = [] {
+    base32::Error err{};
+    const std::string_view inputs[] = {"MY======", "MZX!6YTB", "MZXW6YTB"};
+    base32::Bytes arena(32);
+    size_t lengths[3]{7, 7, 7};
+
+    const size_t written = base32::decodeBatch(inputs, arena, lengths, err);
+
+    expect(err == base32::Error::InvalidB32Input);
+    expect(written == 1_u);
+    expect(lengths[0] == 1_u && lengths[1] == 0_u && lengths[2] == 0_u);
+  };
+
+  test("fixed_width_decode") = [] {
+    const std::array<uint8_t, 6> foobar{'f', 'o', 'o', 'b', 'a', 'r'};
+    expect(base32::decode<6>("MZXW6YTBOI======").value() == foobar);
+    expect(base32::decode<6>("MZXW6YTBOI").value() == foobar);
+    expect(base32::decode<6>("MZXW 6YTB OI").value() == foobar);
+    expect(base32::decode<5>("MZXW6YTB").value() == std::array<uint8_t, 5>{'f', 'o', 'o', 'b', 'a'});
+
+    const auto invalid = base32::decode<6>("MZXW6YTBO!======");
+    expect(!invalid.has_value() && invalid.error().offset == 9_u);
+    expect(base32::decode<6>("MZXW6YTBOI=====A").error().error == base32::Error::InvalidB32Input);
+    const auto shorter = base32::decode<6>("MZXW6YTB");
+    expect(!shorter.has_value() && shorter.error().offset == 8_u);
+
+    base32::Error err{};
+    std::array<uint8_t, 16> uuid{};
+    for (size_t i = 0; i < uuid.size(); i++) {
+      uuid[i] = static_cast<uint8_t>(i * 151 + 7);
+    }
+    const auto encoded = base32::encode(base32::Bytes(uuid.begin(), uuid.end()), err);
+    expect(base32::decode<16>(encoded).value() == uuid);
+  };
+
+  test("decode_line_wrapped") = [] {
+    base32::Error err{};
+    base32::Bytes bytes(64 * 1024 + 3);
+    for (size_t i = 0; i < bytes.size(); i++) {
+      bytes[i] = static_cast<uint8_t>(i * 131 + i / 7);
+    }
+
+    const base32::DecodeOptions options{.skipAllWhitespaces = true};
+    for (const size_t width: {64, 76}) {
+      const std::string wrapped = base32::encode(bytes, err, base32::EncodeOptions{.lineWidth = width});
+      expect(base32::decode(wrapped, err, options) == bytes);
+      expect(err == base32::Error::NoError);
+      expect(base32::decode(wrapped + "\r\n", err, base32::DecodeOptions{.skipAllWhitespaces = true, .requirePadding = true}) == bytes);
+      expect(err == base32::Error::NoError);
+
+      base32::decode(wrapped, err);
+      expect(err == base32::Error::InvalidB32Input);
+    }
+  };
+};
@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <boost/ut.hpp>
 #include <cstring>
+#include <memory_resource>
 
 #include "base32/base32.hpp"
 
@@ -107,6 +109,20 @@ suite<"b32_encode"> b32_encode = [] {
     expect(err == base32::Error::MaxLengthExceeded);
   };
 
+  test("input_limit_option") = [] {
+    base32::Error err{};
+    const auto k = stringToBytes(std::string(65 * 1024 * 1024, 'a'));
+
+    const auto ek = base32::encode(k, err, {.maxInputLength = base32::gNoInputLimit});
+    expect(err == base32::Error::NoError);
+    expect(ek.size() == base32::encodedSize(k.size()));
+
+    expect(base32::encode(stringToBytes("fooba"), err, {.maxInputLength = 5}) == "MZXW6YTB");
+    expect(err == base32::Error::NoError);
+    expect(base32::encode(stringToBytes("foobar"), err, {.maxInputLength = 5}).empty());
+    expect(err == base32::Error::MaxLengthExceeded);
+  };
+
   test("test_input_all_zeroes") = [] {
     base32::Error err{};
     const base32::Bytes secret_bytes{0, 0, 0, 0};
@@ -116,4 +132,201 @@ suite<"b32_encode"> b32_encode = [] {
     expect(err == base32::Error::NoError);
     expect(encoded_str == "AAAAAAA=");
   };
+
+  test("encode_into_rfc4648") = [] {
+    base32::Error err{};
+    const char *k[] = {"", "f", "fo", "foo", "foob", "fooba", "foobar"};
+    const char *k_enc[]
+        = {"", "MY======", "MZXQ====", "MZXW6===", "MZXW6YQ=", "MZXW6YTB", "MZXW6YTBOI======"};
+
+    for (int i = 0; i < 7; i++) {
+      const auto bytes = stringToBytes(k[i]);
+      std::string buffer(base32::encodedSize(bytes.size()), '\0');
+      const size_t written = base32::encodeInto(bytes, buffer, err);
+      expect(err == base32::Error::NoError);
+      expect(written == std::strlen(k_enc[i]));
+      expect(buffer == k_enc[i]);
+    }
+  };
+
+  test("encode_into_buffer_too_small") = [] {
+    base32::Error err{};
+    const auto bytes = stringToBytes("foobar");
+    std::string buffer(base32::encodedSize(bytes.size()) - 1, '\0');
+
+    const size_t written = base32::encodeInto(bytes, buffer, err);
+
+    expect(written == 0_u);
+    expect(err == base32::Error::BufferTooSmall);
+  };
+
+  test("roundtrip_all_tail_lengths") = [] {
+    base32::Error err{};
+    base32::Bytes bytes;
+    for (int i = 0; i < 64; i++) {
+      const auto encoded = base32::encode(bytes, err);
+      expect(err == base32::Error::NoError);
+      expect(encoded.size() == base32::encodedSize(bytes.size()));
+      expect(base32::decode(encoded, err) == bytes);
+      bytes.push_back(static_cast<uint8_t>(i * 37 + 11));
+    }
+  };
+
+  test("padding_disabled") = [] {
+    base32::Error err{};
+    base32::Bytes bytes;
+    const base32::EncodeOptions options{.padding = base32::Padding::Disabled};
+    for (int i = 0; i < 64; i++) {
+      std::string padded = base32::encode(bytes, err);
+      padded.erase(padded.find_last_not_of('=') + 1);
+
+      const auto encoded = base32::encode(bytes, err, options);
+      expect(err == base32::Error::NoError);
+      expect(encoded == padded);
+      expect(encoded.size() == base32::encodedSize(bytes.size(), base32::Padding::Disabled));
+      expect(base32::decode(encoded, err) == bytes);
+      bytes.push_back(static_cast<uint8_t>(i * 37 + 11));
+    }
+  };
+
+  test("encode_into_pmr_string") = [] {
+    std::array<std::byte, 1024> buffer{};
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    const auto encoded = base32::encode(stringToBytes("foobar"), std::pmr::string(&arena));
+
+    expect(encoded.has_value());
+    expect(*encoded == "MZXW6YTBOI======");
+    expect(encoded->get_allocator().resource() == &arena);
+    expect(base32::encode(stringToBytes("foo"), std::vector<char>{}, {.padding = base32::Padding::Disabled}).value()
+           == std::vector<char>{'M', 'Z', 'X', 'W', '6'});
+  };
+
+  test("encode_into_container_rejects_before_resize") = [] {
+    // any allocation of the container throws bad_alloc
+    const base32::Bytes bytes(64, 'f');
+    const auto limited = base32::encode(bytes, std::pmr::string(std::pmr::null_memory_resource()), {.maxInputLength = 32});
+    expect(!limited.has_value());
+    expect(limited.error() == base32::Error::MaxLengthExceeded);
+
+    // separators of 1 character lines don't fit size_t, encode rejects the saturated length before resizing
+    expect(base32::encodedSize(base32::gNoInputLimit / 16 * 5, {.lineWidth = 1}) == base32::gNoInputLimit);
+    expect(base32::encodedSize(base32::gNoInputLimit / 16 * 5, {.lineWidth = 1, .lineSeparator = ""})
+           == base32::gNoInputLimit / 16 * 8);
+  };
+
+  test("backends_match_scalar") = [] {
+    base32::Error err{};
+    base32::Bytes bytes;
+    std::vector<std::string> expected;
+    expect(base32::selectBackend(base32::Backend::Scalar));
+    for (int i = 0; i < 256; i++) {
+      expected.push_back(base32::encode(bytes, err));
+      bytes.push_back(static_cast<uint8_t>(i * 151 + 7));
+    }
+
+    for (const auto backend: {base32::Backend::Sse41, base32::Backend::Avx2, base32::Backend::Avx512, base32::Backend::Neon}) {
+      if (!base32::selectBackend(backend)) {
+        continue;
+      }
+      expect(base32::activeBackend() == backend);
+      for (size_t i = 0; i < expected.size(); i++) {
+        const auto prefix = base32::Bytes(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(i));
+        expect(base32::encode(prefix, err) == expected[i]);
+      }
+    }
+    base32::resetBackend();
+  };
+
+  test("parallel_matches_sequential") = [] {
+    base32::Error err{};
+    base32::Bytes bytes(3 * 1024 * 1024 + 3);
+    for (size_t i = 0; i < bytes.size(); i++) {
+      bytes[i] = static_cast<uint8_t>(i * 131 + i / 7);
+    }
+    const auto expected = base32::encode(bytes, err);
+
+    const auto encoded = base32::encode(bytes, err, {.threads = 4, .parallelThreshold = 0});
+
+    expect(err == base32::Error::NoError);
+    expect(encoded == expected);
+  };
+
+  test("encode_batch") = [] {
+    base32::Error err{};
+    const base32::Bytes items[] = {stringToBytes(""), stringToBytes("f"), stringToBytes("fooba"),
+                                   stringToBytes("foobar")};
+    const std::span<const uint8_t> inputs[] = {items[0], items[1], items[2], items[3]};
+    std::string arena(8 + 8 + 16, '\0');
+    size_t lengths[4]{};
+
+    const size_t written = base32::encodeBatch(inputs, arena, lengths, err);
+
+    expect(err == base32::Error::NoError);
+    expect(written == arena.size());
+    expect(arena == "MY======MZXW6YTBMZXW6YTBOI======");
+    expect(lengths[0] == 0_u && lengths[1] == 8_u && lengths[2] == 8_u && lengths[3] == 16_u);
+
+    base32::encodeBatch(inputs, std::span(arena).first(31), lengths, err);
+    expect(err == base32::Error::BufferTooSmall);
+  };
+
+  test("fixed_width_matches_encode") = [] {
+    base32::Error err{};
+    std::array<uint8_t, 32> digest{};
+    for (size_t i = 0; i < digest.size(); i++) {
+      digest[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+
+    const auto check = [&]<size_t N>(std::integral_constant<size_t, N>) {
+      std::array<uint8_t, N> bytes{};
+      std::copy_n(digest.begin(), N, bytes.begin());
+      const auto encoded = base32::encode(bytes);
+      expect(std::string_view(encoded.data(), encoded.size()) == base32::encode(base32::Bytes(bytes.begin(), bytes.end()), err));
+    };
+    check(std::integral_constant<size_t, 1>{});
+    check(std::integral_constant<size_t, 5>{});
+    check(std::integral_constant<size_t, 10>{});
+    check(std::integral_constant<size_t, 16>{});
+    check(std::integral_constant<size_t, 20>{});
+    check(std::integral_constant<size_t, 32>{});
+  };
+
+  test("line_wrapped_output") = [] {
+    base32::Error err{};
+    const auto wrap = [](std::string_view encoded, size_t width, std::string_view separator) {
+      std::string wrapped;
+      for (size_t offset = 0; offset < encoded.size(); offset += width) {
+        if (offset != 0) {
+          wrapped += separator;
+        }
+        wrapped += encoded.substr(offset, width);
+      }
+
+      return wrapped;
+    };
+
+    base32::Bytes bytes;
+    for (size_t i = 0; i < 203; i++) {
+      bytes.push_back(static_cast<uint8_t>(i * 131 + 7));
+      for (const size_t width: {1, 7, 8, 64, 76}) {
+        for (const auto padding: {base32::Padding::Enabled, base32::Padding::Disabled}) {
+          const base32::EncodeOptions options{.padding = padding, .lineWidth = width, .lineSeparator = i % 2 == 0 ? "\r\n" : "\n"};
+          const base32::EncodeOptions plain{.padding = padding};
+          const std::string expected = wrap(base32::encode(bytes, err, plain), width, options.lineSeparator);
+          expect(base32::encodedSize(bytes.size(), options) == expected.size());
+          expect(base32::encode(bytes, err, options) == expected);
+        }
+      }
+    }
+
+    const base32::EncodeOptions options{.lineWidth = 8};
+    std::array<char, 18> output{};
+    expect(base32::encodeInto(stringToBytes("foobarbaz"), output, err, options) == 18_u);
+    expect(err == base32::Error::NoError);
+    expect(std::string_view(output.data(), output.size()) == "MZXW6YTB\r\nOJRGC6Q=");
+    base32::encodeInto(stringToBytes("foobarbaz12"), output, err, options);
+    expect(err == base32::Error::BufferTooSmall);
+    expect(base32::encode(base32::Bytes{}, err, options).empty());
+  };
 };
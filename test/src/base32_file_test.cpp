@@ -0,0 +1,139 @@
+#include <boost/ut.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "base32/base32.hpp"
+#include "base32/file.hpp"
+
+using namespace boost::ut;
+
+constexpr base32::Bytes stringToBytes(std::string_view str) {
+  base32::Bytes result;
+  for (const auto ch: str) {
+    result.push_back(ch);
+  }
+
+  return result;
+}
+
+std::filesystem::path tempPath(std::string_view name) {
+  return std::filesystem::temp_directory_path() / (std::string("base32_file_test_") + std::string(name));
+}
+
+void writeFile(const std::filesystem::path& path, std::string_view content) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(content.data(), static_cast<std::streamsize>(content.size()));
+}
+
+std::string readFile(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+suite<"b32_file"> b32_file = [] {
+  const auto plainPath = tempPath("plain");
+  const auto encodedPath = tempPath("encoded");
+  const auto decodedPath = tempPath("decoded");
+
+  test("file_roundtrip_matches_in_memory") = [&] {
+    for (const size_t size: {0, 1, 4, 5, 17, 4099}) {
+      std::string plain;
+      for (size_t i = 0; i < size; i++) {
+        plain.push_back(static_cast<char>(i * 131 + 7));
+      }
+      writeFile(plainPath, plain);
+
+      base32::Error err{};
+      expect(base32::encodeFile(plainPath, encodedPath) == base32::Error::NoError);
+      expect(readFile(encodedPath) == base32::encode(stringToBytes(plain), err));
+
+      expect(base32::decodeFile(encodedPath, decodedPath) == base32::Error::NoError);
+      expect(readFile(decodedPath) == plain);
+    }
+  };
+
+  test("file_options") = [&] {
+    writeFile(plainPath, "foobar");
+    expect(base32::encodeFile(plainPath, encodedPath, {.padding = base32::Padding::Disabled}) == base32::Error::NoError);
+    expect(readFile(encodedPath) == "MZXW6YTBOI");
+
+    writeFile(encodedPath, "mzxw 6ytb\noi======\n");
+    expect(base32::decodeFile(encodedPath, decodedPath, {.ignoreCase = true, .skipAllWhitespaces = true})
+           == base32::Error::NoError);
+    expect(readFile(decodedPath) == "foobar");
+  };
+
+  test("file_line_wrapped") = [&] {
+    // more than one chunk of 4M blocks, so separators between chunks are covered
+    for (const size_t size: {4099, 21 * 1024 * 1024 + 3}) {
+      std::string plain;
+      for (size_t i = 0; i < size; i++) {
+        plain.push_back(static_cast<char>(i * 131 + i / 7));
+      }
+      writeFile(plainPath, plain);
+
+      for (const size_t width: {64, 76}) {
+        const base32::EncodeOptions options{.lineWidth = width, .lineSeparator = "\n"};
+        base32::Error err{};
+        expect(base32::encodeFile(plainPath, encodedPath, options) == base32::Error::NoError);
+        expect(readFile(encodedPath) == base32::encode(stringToBytes(plain), err, options));
+
+        expect(base32::decodeFile(encodedPath, decodedPath, {.skipAllWhitespaces = true}) == base32::Error::NoError);
+        expect(readFile(decodedPath) == plain);
+        expect(base32::decodeFile(encodedPath, decodedPath,
+                                  {.threads = 4, .parallelThreshold = 0, .skipAllWhitespaces = true})
+               == base32::Error::NoError);
+        expect(readFile(decodedPath) == plain);
+      }
+    }
+  };
+
+  test("file_parallel_decode_with_whitespaces") = [&] {
+    // the space is in the first chunk of 32M characters, so the chunk ends with a partial block
+    std::string plain;
+    for (size_t i = 0; i < 25 * 1024 * 1024; i++) {
+      plain.push_back(static_cast<char>(i * 151 + i / 5));
+    }
+    base32::Error err{};
+    std::string encoded = base32::encode(stringToBytes(plain), err, {.maxInputLength = base32::gNoInputLimit});
+    encoded.insert(30000000, " ");
+    writeFile(encodedPath, encoded);
+
+    expect(base32::decodeFile(encodedPath, decodedPath, {.threads = 4, .parallelThreshold = 0})
+           == base32::Error::NoError);
+    expect(readFile(decodedPath) == plain);
+  };
+
+  test("file_errors") = [&] {
+    writeFile(decodedPath, "untouched");
+    writeFile(encodedPath, "MZXW6YT!");
+    expect(base32::decodeFile(encodedPath, decodedPath) == base32::Error::InvalidB32Input);
+    expect(readFile(decodedPath) == "untouched");
+
+    writeFile(encodedPath, "MZXW6YTBOI");
+    expect(base32::decodeFile(encodedPath, decodedPath, {.requirePadding = true}) == base32::Error::InvalidB32Input);
+
+    expect(base32::encodeFile(tempPath("missing"), encodedPath) == base32::Error::IoError);
+    expect(base32::decodeFile(tempPath("missing"), decodedPath) == base32::Error::IoError);
+  };
+
+  test("file_same_input_and_output") = [&] {
+    writeFile(plainPath, "foobar");
+    expect(base32::encodeFile(plainPath, plainPath) == base32::Error::IoError);
+    expect(readFile(plainPath) == "foobar");
+    expect(base32::encodeFile(plainPath, plainPath.parent_path() / "." / plainPath.filename())
+           == base32::Error::IoError);
+    expect(readFile(plainPath) == "foobar");
+
+    writeFile(encodedPath, "MZXW6YTBOI======");
+    expect(base32::decodeFile(encodedPath, encodedPath) == base32::Error::IoError);
+    expect(readFile(encodedPath) == "MZXW6YTBOI======");
+  };
+
+  std::filesystem::remove(plainPath);
+  std::filesystem::remove(encodedPath);
+  std::filesystem::remove(decodedPath);
+};
@@ -0,0 +1,81 @@
+#include <boost/ut.hpp>
+
+#include <numeric>
+
+#include "base32/base32.hpp"
+#include "base32/checksum.hpp"
+#include "base32/stats.hpp"
+#include "base32/views.hpp"
+
+using namespace boost::ut;
+
+constexpr base32::Bytes stringToBytes(std::string_view str) {
+  base32::Bytes result;
+  for (const auto ch: str) {
+    result.push_back(ch);
+  }
+
+  return result;
+}
+
+suite<"b32_stats"> b32_stats = [] {
+  test("calls_are_counted_when_enabled") = [] {
+    base32::resetStats();
+    base32::Error err{};
+    base32::encode(stringToBytes("foobar"), err);
+    base32::decode("MZXW6YTBOI======", err);
+    base32::decode("MZXW6YT!", err);
+    expect(base32::validate("MZXW6YTB") == base32::Error::NoError);
+
+    const auto stats = base32::statsSnapshot();
+    const auto& encode = stats.of(base32::activeBackend(), base32::Operation::Encode);
+    const auto& decode = stats.of(base32::activeBackend(), base32::Operation::Decode);
+    const auto& validate = stats.of(base32::activeBackend(), base32::Operation::Validate);
+    if (!base32::statsEnabled()) {
+      expect(encode.calls == 0_u && decode.calls == 0_u && validate.calls == 0_u);
+      return;
+    }
+
+    expect(encode.calls == 1_u);
+    expect(encode.bytesIn == 6_u);
+    expect(encode.bytesOut == 16_u);
+    expect(decode.calls == 2_u);
+    expect(decode.bytesIn == 24_u);
+    expect(decode.errors[static_cast<size_t>(base32::Error::NoError)] == 1_u);
+    expect(decode.errors[static_cast<size_t>(base32::Error::InvalidB32Input)] == 1_u);
+    expect(std::accumulate(decode.latency.begin(), decode.latency.end(), uint64_t{0}) == 2_u);
+    expect(validate.calls == 1_u);
+
+    base32::resetStats();
+    expect(base32::statsSnapshot().of(base32::activeBackend(), base32::Operation::Encode).calls == 0_u);
+  };
+
+  test("public_calls_are_counted_once") = [] {
+    if (!base32::statsEnabled()) {
+      return;
+    }
+
+    base32::resetStats();
+    base32::Error err{};
+    const base32::Bytes bytes(base32::gHashChunkBytes * 3 + 1, 'f');
+    std::string output(base32::encodedSize(bytes.size()), '\0');
+    base32::Crc32c crc;
+    base32::encodeIntoHashed(bytes, output, err, crc);
+    base32::encode(bytes, err, {.maxInputLength = 4});
+    expect(err == base32::Error::MaxLengthExceeded);
+    base32::decode(output, err, {.maxInputLength = 4});
+    expect(err == base32::Error::MaxLengthExceeded);
+    for ([[maybe_unused]] const char ch: bytes | base32::views::encode) {
+    }
+
+    const auto stats = base32::statsSnapshot();
+    const auto& encode = stats.of(base32::activeBackend(), base32::Operation::Encode);
+    const auto& decode = stats.of(base32::activeBackend(), base32::Operation::Decode);
+    expect(encode.calls == 2_u);
+    expect(encode.bytesIn == 2 * bytes.size());
+    expect(encode.bytesOut == output.size());
+    expect(encode.errors[static_cast<size_t>(base32::Error::MaxLengthExceeded)] == 1_u);
+    expect(decode.calls == 1_u);
+    expect(decode.errors[static_cast<size_t>(base32::Error::MaxLengthExceeded)] == 1_u);
+  };
+};
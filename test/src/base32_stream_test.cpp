@@ -0,0 +1,194 @@
+#include <boost/ut.hpp>
+#include <cstring>
+#include <vector>
+
+#include "base32/base32.hpp"
+
+using namespace boost::ut;
+
+constexpr base32::Bytes stringToBytes(std::string_view str) {
+  base32::Bytes result;
+  for (const auto ch: str) {
+    result.push_back(ch);
+  }
+
+  return result;
+}
+
+suite<"b32_stream"> b32_stream = [] {
+  test("encoder_chunks") = [] {
+    base32::Error err{};
+    base32::Bytes bytes;
+    for (int i = 0; i < 203; i++) {
+      bytes.push_back(static_cast<uint8_t>(i * 29 + 3));
+    }
+    const auto expected = base32::encode(bytes, err);
+
+    for (size_t chunkSize = 1; chunkSize < 24; chunkSize++) {
+      base32::Encoder encoder;
+      std::string encoded;
+      for (size_t pos = 0; pos < bytes.size(); pos += chunkSize) {
+        const auto chunk = std::span(bytes).subspan(pos, std::min(chunkSize, bytes.size() - pos));
+        std::string out(encoder.updateSize(chunk.size()), '\0');
+        out.resize(encoder.update(chunk, out, err));
+        expect(err == base32::Error::NoError);
+        encoded += out;
+      }
+      std::string out(encoder.finalizeSize(), '\0');
+      out.resize(encoder.finalize(out, err));
+      encoded += out;
+
+      expect(encoded == expected);
+    }
+  };
+
+  test("encoder_rfc4648") = [] {
+    base32::Error err{};
+    const char *k[] = {"", "f", "fo", "foo", "foob", "fooba", "foobar"};
+    const char *k_enc[]
+        = {"", "MY======", "MZXQ====", "MZXW6===", "MZXW6YQ=", "MZXW6YTB", "MZXW6YTBOI======"};
+
+    base32::Encoder encoder;
+    for (int i = 0; i < 7; i++) {
+      const auto bytes = stringToBytes(k[i]);
+      std::string encoded(encoder.updateSize(bytes.size()), '\0');
+      encoded.resize(encoder.update(bytes, encoded, err));
+      std::string tail(encoder.finalizeSize(), '\0');
+      tail.resize(encoder.finalize(tail, err));
+
+      expect(encoded + tail == k_enc[i]);
+    }
+  };
+
+  test("encoder_empty_chunk") = [] {
+    base32::Error err{};
+    base32::Encoder encoder;
+    std::string encoded(16, '\0');
+
+    // empty spans have null data, with and without carried over bytes
+    expect(encoder.update({}, encoded, err) == 0_u);
+    expect(encoder.update(stringToBytes("fo"), encoded, err) == 0_u);
+    expect(encoder.update({}, encoded, err) == 0_u);
+    expect(err == base32::Error::NoError);
+    encoded.resize(encoder.finalize(encoded, err));
+    expect(encoded == "MZXQ====");
+  };
+
+  test("encoder_buffer_too_small") = [] {
+    base32::Error err{};
+    base32::Encoder encoder;
+    std::string out(7, '\0');
+
+    expect(encoder.update(stringToBytes("fooba"), out, err) == 0_u);
+    expect(err == base32::Error::BufferTooSmall);
+  };
+
+  test("decoder_chunks") = [] {
+    base32::Error err{};
+    const std::string encoded = "IFCEMRZU GEZSDQVD EQSS MJRIFAXT6 XWDU7B2SKS3LURSS LJOFR6DYPRL MY====== ";
+    const auto expected = stringToBytes("ADFG413!£$%&&((/?^çé*[]#)-.,|<>+f");
+
+    for (size_t chunkSize = 1; chunkSize < 24; chunkSize++) {
+      base32::Decoder decoder;
+      base32::Bytes decoded;
+      for (size_t pos = 0; pos < encoded.size(); pos += chunkSize) {
+        const auto chunk = std::string_view(encoded).substr(pos, chunkSize);
+        base32::Bytes out(decoder.updateSize(chunk.size()));
+        out.resize(decoder.update(chunk, out, err));
+        expect(err == base32::Error::NoError);
+        decoded.insert(decoded.end(), out.begin(), out.end());
+      }
+      base32::Bytes out(decoder.finalizeSize());
+      out.resize(decoder.finalize(out, err));
+      decoded.insert(decoded.end(), out.begin(), out.end());
+
+      expect(decoded == expected);
+    }
+  };
+
+  test("decoder_data_after_padding") = [] {
+    base32::Error err{};
+    base32::Decoder decoder;
+    base32::Bytes out(16);
+
+    decoder.update("MY==", out, err);
+    expect(err == base32::Error::NoError);
+    decoder.update("==MY", out, err);
+    expect(err == base32::Error::InvalidB32Input);
+
+    decoder.reset();
+    decoder.update("MZXW6YTB", out, err);
+    expect(err == base32::Error::NoError);
+  };
+
+  test("decoder_invalid_input") = [] {
+    base32::Error err{};
+    base32::Decoder decoder;
+    base32::Bytes out(16);
+
+    decoder.update("MZXW6YT!", out, err);
+    expect(err == base32::Error::InvalidB32Input);
+  };
+
+  test("segments_match_contiguous") = [] {
+    base32::Error err{};
+    base32::Bytes bytes;
+    for (int i = 0; i < 203; i++) {
+      bytes.push_back(static_cast<uint8_t>(i * 29 + 3));
+    }
+    const auto expected = base32::encode(bytes, err);
+
+    for (size_t inputSize = 1; inputSize < 24; inputSize += 3) {
+      for (size_t outputSize = 1; outputSize < 24; outputSize += 2) {
+        std::vector<std::span<const uint8_t>> inputs;
+        for (size_t pos = 0; pos < bytes.size(); pos += inputSize) {
+          inputs.push_back(std::span(bytes).subspan(pos, std::min(inputSize, bytes.size() - pos)));
+        }
+        std::string encoded(expected.size(), '\0');
+        std::vector<std::span<char>> outputs;
+        for (size_t pos = 0; pos < encoded.size(); pos += outputSize) {
+          outputs.push_back(std::span(encoded).subspan(pos, std::min(outputSize, encoded.size() - pos)));
+        }
+
+        expect(base32::encodeSegments(inputs, outputs, err) == expected.size());
+        expect(err == base32::Error::NoError);
+        expect(encoded == expected);
+
+        std::vector<std::string_view> encodedInputs;
+        for (size_t pos = 0; pos < encoded.size(); pos += inputSize) {
+          encodedInputs.push_back(std::string_view(encoded).substr(pos, inputSize));
+        }
+        base32::Bytes decoded(bytes.size());
+        std::vector<std::span<uint8_t>> decodedOutputs;
+        for (size_t pos = 0; pos < decoded.size(); pos += outputSize) {
+          decodedOutputs.push_back(std::span(decoded).subspan(pos, std::min(outputSize, decoded.size() - pos)));
+        }
+
+        expect(base32::decodeSegments(encodedInputs, decodedOutputs, err) == bytes.size());
+        expect(err == base32::Error::NoError);
+        expect(decoded == bytes);
+      }
+    }
+  };
+
+  test("segments_errors") = [] {
+    base32::Error err{};
+    const auto bytes = stringToBytes("foobar");
+    const std::array<std::span<const uint8_t>, 1> inputs{bytes};
+    std::string encoded(15, '\0');
+    const std::array<std::span<char>, 1> outputs{std::span(encoded)};
+    expect(base32::encodeSegments(inputs, outputs, err) == 0_u);
+    expect(err == base32::Error::BufferTooSmall);
+
+    base32::Bytes decoded(5);
+    const std::array<std::span<uint8_t>, 2> decodedOutputs{std::span(decoded).first(3), std::span(decoded).subspan(3)};
+    const std::array<std::string_view, 2> encodedInputs{"MZXW6", "YTBOI==="};
+    expect(base32::decodeSegments(encodedInputs, decodedOutputs, err) == 5_u);
+    expect(err == base32::Error::BufferTooSmall);
+    expect(decoded == stringToBytes("fooba"));
+
+    const std::array<std::string_view, 2> invalidInputs{"MZXW6", "YT!"};
+    base32::decodeSegments(invalidInputs, decodedOutputs, err);
+    expect(err == base32::Error::InvalidB32Input);
+  };
+};
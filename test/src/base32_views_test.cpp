@@ -0,0 +1,82 @@
+#include <boost/ut.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <ranges>
+#include <string>
+
+#include "base32/base32.hpp"
+#include "base32/views.hpp"
+
+using namespace boost::ut;
+
+constexpr base32::Bytes stringToBytes(std::string_view str) {
+  base32::Bytes result;
+  for (const auto ch: str) {
+    result.push_back(ch);
+  }
+
+  return result;
+}
+
+static_assert(std::ranges::input_range<base32::EncodeView<std::views::all_t<base32::Bytes&>>>);
+static_assert(std::ranges::input_range<base32::DecodeView<std::string_view>>);
+
+suite<"b32_views"> b32_views = [] {
+  test("encode_view_matches_encode") = [] {
+    base32::Error err{};
+    for (const size_t size: {0, 1, 4, 5, 17, 319, 320, 321, 1029}) {
+      base32::Bytes bytes;
+      for (size_t i = 0; i < size; i++) {
+        bytes.push_back(static_cast<uint8_t>(i * 131 + 7));
+      }
+
+      auto view = bytes | base32::views::encode;
+      expect(view.size() == base32::encodedSize(size));
+      std::string encoded;
+      std::ranges::copy(view, std::back_inserter(encoded));
+      expect(encoded == base32::encode(bytes, err));
+    }
+  };
+
+  test("decode_view_matches_decode") = [] {
+    base32::Error err{};
+    for (const size_t size: {0, 1, 4, 5, 17, 319, 320, 321, 1029}) {
+      base32::Bytes bytes;
+      for (size_t i = 0; i < size; i++) {
+        bytes.push_back(static_cast<uint8_t>(i * 131 + 7));
+      }
+      const std::string encoded = base32::encode(bytes, err);
+
+      // non contiguous input is consumed element by element
+      const std::list<char> chars(encoded.begin(), encoded.end());
+      auto view = base32::views::decode(chars);
+      base32::Bytes decoded;
+      std::ranges::copy(view, std::back_inserter(decoded));
+      expect(decoded == bytes);
+      expect(view.error() == base32::Error::NoError);
+    }
+  };
+
+  test("views_compose") = [] {
+    const std::string_view plain = "foobar";
+    auto encoded = plain | base32::views::encode;
+    std::string chars;
+    std::ranges::copy(encoded, std::back_inserter(chars));
+    expect(chars == "MZXW6YTBOI======");
+
+    auto decoded = std::string_view("MZXW 6YTB OI======") | base32::views::decode | std::views::take(3);
+    base32::Bytes bytes;
+    std::ranges::copy(decoded, std::back_inserter(bytes));
+    expect(bytes == stringToBytes("foo"));
+  };
+
+  test("decode_view_error") = [] {
+    auto view = std::string_view("MZXW6YTB!") | base32::views::decode;
+    base32::Bytes bytes;
+    std::ranges::copy(view, std::back_inserter(bytes));
+    expect(bytes == stringToBytes("fooba"));
+    expect(view.error() == base32::Error::InvalidB32Input);
+  };
+};
@@ -0,0 +1,127 @@
+#include <charconv>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+#include "base32/file.hpp"
+
+namespace {
+  constexpr std::string_view gUsage =
+    "usage: base32 encode [--no-padding] [--wrap COLUMNS] [--lf] [--threads N] INPUT OUTPUT\n"
+    "       base32 decode [--ignore-case] [--skip-whitespaces] [--require-padding] [--threads N]"
+    " INPUT OUTPUT\n";
+
+  /*!
+   * \brief errorMessage
+   * \param errCode
+   * \return human readable description of error
+   */
+  std::string_view errorMessage(base32::Error errCode) {
+    switch (errCode) {
+      case base32::Error::NoError:
+        return "no error";
+      case base32::Error::InvalidB32Input:
+        return "invalid base32 input";
+      case base32::Error::MaxLengthExceeded:
+        return "input is too long";
+      case base32::Error::EmptyString:
+        return "empty input";
+      case base32::Error::BufferTooSmall:
+        return "output buffer is too small";
+      case base32::Error::IoError:
+        return "file can't be read or written";
+    }
+
+    return "unknown error";
+  }
+
+  /*!
+   * \brief parseNumber
+   * \param value decimal digits only, sign and whitespaces are rejected
+   * \param max greatest accepted number
+   * \param number
+   * \return false if value is not a number or is greater than max
+   */
+  bool parseNumber(std::string_view value, size_t max, size_t& number) {
+    const char* const end = value.data() + value.size();
+    const auto [last, error] = std::from_chars(value.data(), end, number);
+
+    return error == std::errc() && last == end && number <= max;
+  }
+}
+
+int main(int argc, char* argv[]) {
+  const std::span<char*> args(argv, static_cast<size_t>(argc));
+  if (args.size() < 4) {
+    std::cerr << gUsage;
+    return EXIT_FAILURE;
+  }
+
+  const std::string_view command = args[1];
+  base32::EncodeOptions encodeOptions;
+  base32::DecodeOptions decodeOptions;
+  for (size_t i = 2; i + 2 < args.size(); i++) {
+    const std::string_view option = args[i];
+    size_t number = 0;
+    if (option == "--no-padding") {
+      encodeOptions.padding = base32::Padding::Disabled;
+    } else if (option == "--wrap" && i + 3 < args.size()) {
+      if (!parseNumber(args[i + 1], std::numeric_limits<size_t>::max(), number)) {
+        std::cerr << "invalid number of columns " << args[i + 1] << '\n' << gUsage;
+        return EXIT_FAILURE;
+      }
+      encodeOptions.lineWidth = number;
+      i++;
+    } else if (option == "--lf") {
+      encodeOptions.lineSeparator = "\n";
+    } else if (option == "--ignore-case") {
+      decodeOptions.ignoreCase = true;
+    } else if (option == "--skip-whitespaces") {
+      decodeOptions.skipAllWhitespaces = true;
+    } else if (option == "--require-padding") {
+      decodeOptions.requirePadding = true;
+    } else if (option == "--threads" && i + 3 < args.size()) {
+      if (!parseNumber(args[i + 1], std::numeric_limits<unsigned>::max(), number)) {
+        std::cerr << "invalid number of threads " << args[i + 1] << '\n' << gUsage;
+        return EXIT_FAILURE;
+      }
+      encodeOptions.threads = static_cast<unsigned>(number);
+      decodeOptions.threads = static_cast<unsigned>(number);
+      i++;
+    } else {
+      std::cerr << "unknown option " << option << '\n' << gUsage;
+      return EXIT_FAILURE;
+    }
+  }
+
+  const std::string_view input = args[args.size() - 2];
+  const std::string_view output = args[args.size() - 1];
+  // output is truncated before input is read, the library refuses it as IoError
+  std::error_code sameFileError;
+  if (std::filesystem::equivalent(input, output, sameFileError)) {
+    std::cerr << "base32: input and output are the same file\n";
+    return EXIT_FAILURE;
+  }
+
+  base32::Error errCode{};
+  if (command == "encode") {
+    errCode = base32::encodeFile(input, output, encodeOptions);
+  } else if (command == "decode") {
+    errCode = base32::decodeFile(input, output, decodeOptions);
+  } else {
+    std::cerr << gUsage;
+    return EXIT_FAILURE;
+  }
+
+  if (errCode != base32::Error::NoError) {
+    std::cerr << "base32: " << errorMessage(errCode) << '\n';
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}